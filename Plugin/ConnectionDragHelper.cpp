@@ -2,12 +2,21 @@
 #include "NetworkEditor.h"
 #include "PortGraphicsItem.h"
 #include "ConnectionGraphicsItem.h"
+#include "SourceGraphicsItem.h"
 #include "utilpq.h"
 
+#include <pqPipelineFilter.h>
+#include <pqPipelineSource.h>
+#include <pqOutputPort.h>
+#include <pqUndoStack.h>
+
 #include <QGraphicsItem>
 #include <QGraphicsSceneMouseEvent>
 #include <QApplication>
 
+#include <algorithm>
+#include <tuple>
+
 namespace ParaViewNetworkEditor {
 
 ConnectionDragHelper::ConnectionDragHelper(NetworkEditor &editor)
@@ -25,28 +34,97 @@ bool ConnectionDragHelper::eventFilter(QObject *, QEvent *event) {
     auto e = static_cast<QGraphicsSceneMouseEvent *>(event);
 
     auto endItem = editor_.getInputPortGraphicsItemAt(e->scenePos());
-    auto outport = connection_->getOutportGraphicsItem()->getPort();
-    reset();
+    auto outport = connection_->getOutportGraphicsItem();
+    connection_.reset();
 
     if (endItem) {
-      auto inport = endItem->getPort();
       bool force_accept = QApplication::keyboardModifiers() & Qt::ShiftModifier;
-      if (force_accept || utilpq::can_connect(outport.first, outport.second, inport.first, inport.second)) {
-        utilpq::add_connection(outport.first, outport.second, inport.first, inport.second);
-      }
+      addConnections(outport, endItem, force_accept);
     }
+    selection_.clear();
     e->accept();
   }
   return false;
 }
 
 void ConnectionDragHelper::start(OutputPortGraphicsItem *outport, QPointF endPoint, QColor color) {
+  selection_.clear();
+  for (QGraphicsItem *item : editor_.selectedItems()) {
+    if (auto source_item = qgraphicsitem_cast<SourceGraphicsItem *>(item)) {
+      selection_.emplace_back(source_item);
+    }
+  }
   connection_ =
       std::make_unique<ConnectionDragGraphicsItem>(outport, endPoint, color);
   editor_.addItem(connection_.get());
   connection_->show();
 }
 
-void ConnectionDragHelper::reset() { connection_.reset(); }
+void ConnectionDragHelper::reset() {
+  connection_.reset();
+  selection_.clear();
+}
+
+void ConnectionDragHelper::addConnections(OutputPortGraphicsItem *outport, InputPortGraphicsItem *inport, bool force_accept) {
+  pqPipelineSource *source = outport->getPort().first;
+  int out_port = outport->getPort().second;
+  pqPipelineFilter *dest = inport->getPort().first;
+  int in_port = inport->getPort().second;
+  if (!source || !dest)
+    return;
+
+  auto is_selected = [this](SourceGraphicsItem *item) {
+    return std::find(selection_.begin(), selection_.end(), item) != selection_.end();
+  };
+  auto is_connected = [](pqPipelineSource *source, int out_port, pqPipelineFilter *dest, int in_port) {
+    return dest->getInputs(dest->getInputPortName(in_port)).contains(source->getOutputPort(out_port));
+  };
+
+  std::vector<std::tuple<pqPipelineSource *, int, pqPipelineFilter *, int>> connections;
+  if (force_accept || utilpq::can_connect(source, out_port, dest, in_port)) {
+    connections.emplace_back(source, out_port, dest, in_port);
+  }
+
+  bool source_selected = is_selected(outport->getSourceGraphicsItem());
+  bool dest_selected = is_selected(inport->getSourceGraphicsItem());
+  if (dest_selected && !source_selected) {
+    // fan-out
+    for (const auto &item : selection_) {
+      if (!item || item == inport->getSourceGraphicsItem())
+        continue;
+      auto filter = qobject_cast<pqPipelineFilter *>(item->getSource());
+      if (!filter || in_port >= filter->getNumberOfInputPorts() || is_connected(source, out_port, filter, in_port))
+        continue;
+      if (force_accept || utilpq::can_connect(source, out_port, filter, in_port)) {
+        connections.emplace_back(source, out_port, filter, in_port);
+      }
+    }
+  } else if (source_selected && !dest_selected && utilpq::multiple_inputs(dest, in_port)) {
+    // fan-in
+    for (const auto &item : selection_) {
+      if (!item || item == outport->getSourceGraphicsItem())
+        continue;
+      pqPipelineSource *other = item->getSource();
+      if (!other || out_port >= other->getNumberOfOutputPorts() || is_connected(other, out_port, dest, in_port))
+        continue;
+      if (force_accept || utilpq::can_connect(other, out_port, dest, in_port)) {
+        connections.emplace_back(other, out_port, dest, in_port);
+      }
+    }
+  }
+
+  if (connections.empty())
+    return;
+
+  BEGIN_UNDO_SET(connections.size() > 1 ? QString("Add %1 Connections").arg(connections.size()) : QString("Add Connection"));
+  {
+    utilpq::ConnectionTransaction transaction;
+    for (const auto &connection : connections) {
+      utilpq::add_connection(std::get<0>(connection), std::get<1>(connection),
+                             std::get<2>(connection), std::get<3>(connection));
+    }
+  }
+  END_UNDO_SET();
+}
 
 }
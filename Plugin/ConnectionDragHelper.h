@@ -3,8 +3,10 @@
 
 #include <QObject>
 #include <QPointF>
+#include <QPointer>
 
 #include <memory>
+#include <vector>
 
 class QEvent;
 
@@ -13,6 +15,8 @@ namespace ParaViewNetworkEditor {
 class NetworkEditor;
 class ConnectionDragGraphicsItem;
 class OutputPortGraphicsItem;
+class InputPortGraphicsItem;
+class SourceGraphicsItem;
 
 class ConnectionDragHelper : public QObject {
  Q_OBJECT
@@ -27,8 +31,16 @@ class ConnectionDragHelper : public QObject {
   virtual bool eventFilter(QObject *obj, QEvent *event) override;
 
  private:
+  // Connects the dragged output port to the input port. If the target node is selected, the output port
+  // is connected to the same input port of all selected nodes (fan-out). If the dragged node is selected
+  // and the input port accepts multiple inputs, the same output port of all selected nodes is connected
+  // to it (fan-in).
+  void addConnections(OutputPortGraphicsItem *outport, InputPortGraphicsItem *inport, bool force_accept);
+
   NetworkEditor &editor_;
   std::unique_ptr<ConnectionDragGraphicsItem> connection_;
+  // selected nodes when the drag started, activating the output port changes the selection
+  std::vector<QPointer<SourceGraphicsItem>> selection_;
 };
 
 }
@@ -1,6 +1,7 @@
 #include "ConnectionGraphicsItem.h"
 #include "utilpq.h"
 #include "NetworkEditor.h"
+#include "perf_counters.h"
 
 #include <QGraphicsDropShadowEffect>
 #include <QGraphicsSceneHoverEvent>
@@ -52,6 +53,7 @@ QPainterPath CurveGraphicsItem::obtainCurvePath(QPointF startPoint, QPointF endP
 }
 
 void CurveGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *, QWidget *) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   const auto color = getColor();
   if (isSelected()) {
     p->setPen(QPen(selectedBorderColor_, 4.0, Qt::SolidLine, Qt::RoundCap));
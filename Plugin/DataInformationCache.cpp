@@ -0,0 +1,130 @@
+#include "DataInformationCache.h"
+#include "utilpq.h"
+#include "perf_counters.h"
+#include "vtkPVBatchDataInformation.h"
+
+#include <vtkLogger.h>
+#include <vtkNew.h>
+#include <vtkPVDataInformation.h>
+#include <vtkPVSession.h>
+#include <vtkSMSession.h>
+#include <vtkSMSourceProxy.h>
+
+#include <pqApplicationCore.h>
+#include <pqOutputPort.h>
+#include <pqPipelineSource.h>
+#include <pqServer.h>
+#include <pqServerManagerModel.h>
+
+#include <QTimer>
+
+#include <map>
+#include <unordered_set>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+
+DataInformationCache *DataInformationCache::instance() {
+  static DataInformationCache *cache = new DataInformationCache();
+  return cache;
+}
+
+DataInformationCache::DataInformationCache()
+    : QObject(pqApplicationCore::instance()) {
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  for (pqPipelineSource *source : utilpq::get_sources()) {
+    this->addSource(source);
+  }
+  connect(smModel, &pqServerManagerModel::sourceAdded, this, &DataInformationCache::addSource);
+  connect(smModel, &pqServerManagerModel::preSourceRemoved, this, &DataInformationCache::removeSource);
+}
+
+DataInformationCache::~DataInformationCache() = default;
+
+void DataInformationCache::addSource(pqPipelineSource *source) {
+  connect(source, &pqPipelineSource::dataUpdated, this, &DataInformationCache::invalidate);
+}
+
+void DataInformationCache::removeSource(pqPipelineSource *source) {
+  for (pqOutputPort *port : source->getOutputPorts()) {
+    entries_.erase(port);
+  }
+}
+
+void DataInformationCache::invalidate(pqPipelineSource *source) {
+  // only re-gather ports that were asked for, i.e. those that are shown
+  for (pqOutputPort *port : source->getOutputPorts()) {
+    auto it = entries_.find(port);
+    if (it == entries_.end() || !it->second.valid)
+      continue;
+    it->second.valid = false;
+    this->request(port);
+  }
+}
+
+vtkPVDataInformation *DataInformationCache::get(pqOutputPort *port) {
+  if (!port)
+    return nullptr;
+  auto it = entries_.find(port);
+  if (it == entries_.end()) {
+    entries_[port];
+    this->request(port);
+    return nullptr;
+  }
+  return it->second.info;
+}
+
+bool DataInformationCache::isValid(pqOutputPort *port) const {
+  auto it = entries_.find(port);
+  return it != entries_.end() && it->second.valid;
+}
+
+void DataInformationCache::request(pqOutputPort *port) {
+  pending_.emplace_back(port);
+  if (gatherScheduled_)
+    return;
+  gatherScheduled_ = true;
+  QTimer::singleShot(0, this, &DataInformationCache::gather);
+}
+
+void DataInformationCache::gather() {
+  vtkLogScopeF(8, "DataInformationCache::gather");
+  gatherScheduled_ = false;
+  std::vector<QPointer<pqOutputPort>> pending;
+  pending.swap(pending_);
+
+  // one request per server for all of its ports
+  std::map<pqServer *, std::vector<pqOutputPort *>> batches;
+  std::unordered_set<pqOutputPort *> batched;
+  for (const auto &port : pending) {
+    if (!port || !batched.insert(port).second)
+      continue;
+    auto it = entries_.find(port);
+    if (it == entries_.end() || it->second.valid)
+      continue;
+    batches[port->getServer()].push_back(port);
+  }
+
+  QList<pqOutputPort *> ports;
+  for (const auto &kv : batches) {
+    const std::vector<pqOutputPort *> &batch = kv.second;
+    vtkNew<vtkPVBatchDataInformation> information;
+    for (pqOutputPort *port : batch) {
+      information->AddPort(port->getSourceProxy()->GetGlobalID(), port->getPortNumber());
+    }
+    perf_counters::increment(perf_counters::DATA_INFORMATION_QUERIES);
+    kv.first->session()->GatherInformation(vtkPVSession::DATA_SERVER, information,
+                                           batch.front()->getSourceProxy()->GetGlobalID());
+    for (int i = 0; i < static_cast<int>(batch.size()); ++i) {
+      Entry &entry = entries_[batch[i]];
+      entry.info = information->GetDataInformation(i);
+      entry.valid = true;
+      ports.push_back(batch[i]);
+    }
+  }
+  if (!ports.empty()) {
+    emit updated(ports);
+  }
+}
+
+}
@@ -0,0 +1,60 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_DATAINFORMATIONCACHE_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_DATAINFORMATIONCACHE_H_
+
+#include <QObject>
+#include <QPointer>
+
+#include <vtkPVDataInformation.h>
+#include <vtkSmartPointer.h>
+
+#include <unordered_map>
+#include <vector>
+
+class pqOutputPort;
+class pqPipelineSource;
+
+namespace ParaViewNetworkEditor {
+
+// Local cache of the data information of output ports.
+// Painting and tooltips never gather data information themselves, which is a round trip to the server in
+// client/server sessions. Ports that were asked for are gathered once control returns to the event loop, and again
+// after each update of their source, with one vtkPVBatchDataInformation request per server for all of them.
+// The request itself still blocks the event loop until the server replies.
+class DataInformationCache : public QObject {
+ Q_OBJECT
+ public:
+  static DataInformationCache *instance();
+
+  // Returns the data information of the port, or nullptr if it was not gathered yet. The information may be from
+  // before the last update while a new batch is pending. Unknown or outdated ports are added to the next batch.
+  vtkPVDataInformation *get(pqOutputPort *port);
+
+  // True if the information returned by get() is up to date.
+  bool isValid(pqOutputPort *port) const;
+
+ signals:
+  // Emitted after a batch of ports was gathered.
+  void updated(const QList<pqOutputPort *> &ports);
+
+ private:
+  DataInformationCache();
+  ~DataInformationCache() override;
+
+  void addSource(pqPipelineSource *source);
+  void removeSource(pqPipelineSource *source);
+  void invalidate(pqPipelineSource *source);
+  void request(pqOutputPort *port);
+  void gather();
+
+  struct Entry {
+    vtkSmartPointer<vtkPVDataInformation> info;
+    bool valid = false;
+  };
+  std::unordered_map<pqOutputPort *, Entry> entries_;
+  std::vector<QPointer<pqOutputPort>> pending_;
+  bool gatherScheduled_ = false;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_DATAINFORMATIONCACHE_H_
@@ -1,6 +1,9 @@
 #include "EditorGraphicsItem.h"
 #include "NetworkEditor.h"
 #include "utilpq.h"
+#include "DataInformationCache.h"
+#include "ExecutionTimer.h"
+#include "MemoryTotals.h"
 
 #include <pqApplicationCore.h>
 #include <pqServerManagerModel.h>
@@ -10,6 +13,7 @@
 #include <vtkSMSourceProxy.h>
 #include <vtkSMInputProperty.h>
 #include <vtkSMPropertyHelper.h>
+#include <vtkPVDataInformation.h>
 
 #include <QGraphicsScene>
 #include <QGraphicsView>
@@ -58,6 +62,22 @@ void EditorGraphicsItem::showSourceInfo(QGraphicsSceneHelpEvent *event, pqPipeli
   QString s;
   s += "<html><body><table style=\"white-space: nowrap;\">";
   s += "<tr><td>" + source->getSMName() + " (" + QString(source->getSourceProxy()->GetVTKClassName()) + ") </td></tr>";
+  for (int i = 0; i < source->getNumberOfOutputPorts(); ++i) {
+    if (source->getNumberOfOutputPorts() > 1) {
+      s += "<tr><td><b>" + source->getOutputPort(i)->getPortName() + "</b></td></tr>";
+    }
+    s += this->dataInformationRows(source->getOutputPort(i));
+  }
+  auto timer = ExecutionTimer::instance();
+  if (timer->hasTime(source)) {
+    s += "<tr><td>Execution time " + QString::number(timer->lastTime(source), 'f', 3) + " s (total "
+        + QString::number(timer->totalTime(source), 'f', 3) + " s)</td></tr>";
+  }
+  auto totals = MemoryTotals::instance();
+  if (totals->isEnabled()) {
+    s += "<tr><td>Memory including downstream " + QString::number(totals->branchMemory(source) / 1024., 'f', 2)
+        + " MB</td></tr>";
+  }
   s += "</table></body></html>";
   this->showToolTipHelper(event, s);
 }
@@ -94,6 +114,7 @@ void EditorGraphicsItem::showOutportInfo(QGraphicsSceneHelpEvent *event, pqPipel
   s += "<html><body><table style=\"white-space: nowrap;\">";
   s += "<tr><td>" + source->getOutputPort(port)->getPortName() + " (" + QString::number(port) + ")</td></tr>";
   pqOutputPort* output_port = source->getOutputPort(port);
+  s += this->dataInformationRows(output_port);
   const int n = source->getNumberOfConsumers(port);
   for (int i = 0; i < n; ++i) {
     pqPipelineFilter* consumer = static_cast<pqPipelineFilter*>(source->getConsumer(port, i));
@@ -112,6 +133,33 @@ void EditorGraphicsItem::showOutportInfo(QGraphicsSceneHelpEvent *event, pqPipel
   this->showToolTipHelper(event, s);
 }
 
+QString EditorGraphicsItem::dataInformationRows(pqOutputPort *port) const {
+  auto cache = DataInformationCache::instance();
+  vtkPVDataInformation *info = cache->get(port);
+  if (!info || !cache->isValid(port)) {
+    if (auto editor = this->getNetworkEditor()) {
+      editor->refreshToolTipOnDataInformation();
+    }
+    return "<tr><td><i>Gathering data information...</i></td></tr>";
+  }
+  if (!info->GetDataClassName())
+    return "<tr><td><i>No data</i></td></tr>";
+
+  QString s;
+  s += "<tr><td>" + QString(info->GetPrettyDataTypeString()) + "</td></tr>";
+  s += "<tr><td>" + QString::number(info->GetNumberOfPoints()) + " points, "
+      + QString::number(info->GetNumberOfCells()) + " cells</td></tr>";
+  double *bounds = info->GetBounds();
+  if (bounds[0] <= bounds[1]) {
+    s += QString("<tr><td>Bounds [%1, %2] &times; [%3, %4] &times; [%5, %6]</td></tr>")
+        .arg(bounds[0], 0, 'g', 4).arg(bounds[1], 0, 'g', 4)
+        .arg(bounds[2], 0, 'g', 4).arg(bounds[3], 0, 'g', 4)
+        .arg(bounds[4], 0, 'g', 4).arg(bounds[5], 0, 'g', 4);
+  }
+  s += "<tr><td>Memory " + QString::number(info->GetMemorySize() / 1024., 'f', 2) + " MB</td></tr>";
+  return s;
+}
+
 void EditorGraphicsItem::showConnectionInfo(QGraphicsSceneHelpEvent *event,
                                             pqPipelineSource* source, int output_port,
                                             pqPipelineFilter* dest, int input_port) const {
@@ -7,6 +7,7 @@
 
 class pqPipelineSource;
 class pqPipelineFilter;
+class pqOutputPort;
 
 namespace ParaViewNetworkEditor {
 
@@ -54,6 +55,9 @@ class EditorGraphicsItem : public QGraphicsRectItem {
 
  protected:
   void showToolTipHelper(QGraphicsSceneHelpEvent *event, QString string) const;
+  // Table rows with data statistics of the port. Until the data information is gathered, a placeholder is
+  // returned and the tooltip is shown again once it is available.
+  QString dataInformationRows(pqOutputPort *port) const;
   NetworkEditor *getNetworkEditor() const;
 };
 
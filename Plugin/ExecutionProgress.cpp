@@ -0,0 +1,108 @@
+#include "ExecutionProgress.h"
+#include "utilpq.h"
+
+#include <vtkAlgorithm.h>
+#include <vtkCommand.h>
+#include <vtkSMSourceProxy.h>
+
+#include <pqApplicationCore.h>
+#include <pqPipelineSource.h>
+#include <pqServerManagerModel.h>
+
+namespace ParaViewNetworkEditor {
+
+ExecutionProgress *ExecutionProgress::instance() {
+  static ExecutionProgress *progress = new ExecutionProgress();
+  return progress;
+}
+
+ExecutionProgress::ExecutionProgress()
+    : QObject(pqApplicationCore::instance()) {
+  for (pqPipelineSource *source : utilpq::get_sources()) {
+    this->addSource(source);
+  }
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  connect(smModel, &pqServerManagerModel::sourceAdded, this, &ExecutionProgress::addSource);
+  connect(smModel, &pqServerManagerModel::preSourceRemoved, this, &ExecutionProgress::removeSource);
+}
+
+ExecutionProgress::~ExecutionProgress() {
+  for (auto &kv : entries_) {
+    if (vtkObject *algorithm = kv.second.algorithm) {
+      for (unsigned long tag : kv.second.tags)
+        algorithm->RemoveObserver(tag);
+    }
+  }
+}
+
+void ExecutionProgress::addSource(pqPipelineSource *source) {
+  // the client side object is the algorithm itself in builtin sessions only
+  auto smproxy = source->getSourceProxy();
+  auto algorithm = smproxy ? vtkAlgorithm::SafeDownCast(smproxy->GetClientSideObject()) : nullptr;
+  if (!algorithm || entries_.count(source))
+    return;
+  Entry &entry = entries_[source];
+  entry.algorithm = algorithm;
+  entry.tags[0] = algorithm->AddObserver(vtkCommand::StartEvent, this, &ExecutionProgress::onStart);
+  entry.tags[1] = algorithm->AddObserver(vtkCommand::ProgressEvent, this, &ExecutionProgress::onProgress);
+  entry.tags[2] = algorithm->AddObserver(vtkCommand::EndEvent, this, &ExecutionProgress::onEnd);
+  sources_[algorithm] = source;
+}
+
+void ExecutionProgress::removeSource(pqPipelineSource *source) {
+  auto it = entries_.find(source);
+  if (it == entries_.end())
+    return;
+  if (vtkObject *algorithm = it->second.algorithm) {
+    for (unsigned long tag : it->second.tags)
+      algorithm->RemoveObserver(tag);
+    sources_.erase(algorithm);
+  }
+  entries_.erase(it);
+}
+
+void ExecutionProgress::onStart(vtkObject *caller, unsigned long, void *) {
+  auto it = sources_.find(caller);
+  if (it == sources_.end())
+    return;
+  Entry &entry = entries_[it->second];
+  entry.executing = true;
+  entry.progress = 0.;
+  entry.lastChanged = Clock::now();
+  emit changed(it->second);
+}
+
+void ExecutionProgress::onProgress(vtkObject *caller, unsigned long, void *callData) {
+  auto it = sources_.find(caller);
+  if (it == sources_.end() || !callData)
+    return;
+  Entry &entry = entries_[it->second];
+  entry.progress = *static_cast<double *>(callData);
+  const auto now = Clock::now();
+  if (now - entry.lastChanged < std::chrono::milliseconds(1000 / maxRate))
+    return;
+  entry.lastChanged = now;
+  emit changed(it->second);
+}
+
+void ExecutionProgress::onEnd(vtkObject *caller, unsigned long, void *) {
+  auto it = sources_.find(caller);
+  if (it == sources_.end())
+    return;
+  Entry &entry = entries_[it->second];
+  entry.executing = false;
+  entry.progress = 1.;
+  emit changed(it->second);
+}
+
+bool ExecutionProgress::isExecuting(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() && it->second.executing;
+}
+
+double ExecutionProgress::progress(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() ? it->second.progress : 0.;
+}
+
+}
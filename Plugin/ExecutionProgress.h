@@ -0,0 +1,59 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_EXECUTIONPROGRESS_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_EXECUTIONPROGRESS_H_
+
+#include <vtkWeakPointer.h>
+
+#include <QObject>
+
+#include <chrono>
+#include <unordered_map>
+
+class pqPipelineSource;
+class vtkObject;
+
+namespace ParaViewNetworkEditor {
+
+// Tracks which source is executing and its progress, from the StartEvent, ProgressEvent and EndEvent of the
+// sources' algorithms. Algorithms report progress up to thousands of times per second, so the events only
+// store the value and changed() is emitted at most maxRate times per second for each source.
+// Only builtin sessions expose the algorithms to the client; in client/server sessions no progress is shown.
+class ExecutionProgress : public QObject {
+ Q_OBJECT
+ public:
+  static ExecutionProgress *instance();
+
+  static constexpr int maxRate = 25;
+
+  bool isExecuting(pqPipelineSource *source) const;
+  // Progress of the current execution in [0, 1].
+  double progress(pqPipelineSource *source) const;
+
+ signals:
+  void changed(pqPipelineSource *source);
+
+ private:
+  ExecutionProgress();
+  ~ExecutionProgress() override;
+
+  void addSource(pqPipelineSource *source);
+  void removeSource(pqPipelineSource *source);
+
+  void onStart(vtkObject *caller, unsigned long, void *);
+  void onProgress(vtkObject *caller, unsigned long, void *callData);
+  void onEnd(vtkObject *caller, unsigned long, void *);
+
+  using Clock = std::chrono::steady_clock;
+  struct Entry {
+    vtkWeakPointer<vtkObject> algorithm;
+    unsigned long tags[3] = {0, 0, 0};
+    bool executing = false;
+    double progress = 0.;
+    Clock::time_point lastChanged;
+  };
+  std::unordered_map<pqPipelineSource *, Entry> entries_;
+  std::unordered_map<vtkObject *, pqPipelineSource *> sources_;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_EXECUTIONPROGRESS_H_
@@ -0,0 +1,170 @@
+#include "ExecutionTimer.h"
+#include "utilpq.h"
+
+#include <vtkAlgorithm.h>
+#include <vtkCommand.h>
+#include <vtkLogger.h>
+#include <vtkSMSourceProxy.h>
+
+#include <pqApplicationCore.h>
+#include <pqPipelineSource.h>
+#include <pqServerManagerModel.h>
+
+#include <algorithm>
+
+namespace ParaViewNetworkEditor {
+
+ExecutionTimer *ExecutionTimer::instance() {
+  static ExecutionTimer *timer = new ExecutionTimer();
+  return timer;
+}
+
+ExecutionTimer::ExecutionTimer()
+    : QObject(pqApplicationCore::instance()) {
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  connect(smModel, &pqServerManagerModel::sourceAdded, this, &ExecutionTimer::addSource);
+  connect(smModel, &pqServerManagerModel::preSourceRemoved, this, &ExecutionTimer::removeSource);
+}
+
+ExecutionTimer::~ExecutionTimer() {
+  for (auto &kv : entries_) {
+    this->detach(kv.first);
+  }
+}
+
+void ExecutionTimer::setEnabled(bool enabled) {
+  if (enabled_ == enabled)
+    return;
+  enabled_ = enabled;
+  vtkLogScopeF(8, "ExecutionTimer::setEnabled(%d)", enabled);
+  if (enabled) {
+    for (pqPipelineSource *source : utilpq::get_sources()) {
+      this->attach(source);
+    }
+  } else {
+    for (auto &kv : entries_) {
+      this->detach(kv.first);
+    }
+    // timings are accumulated from the moment the timer is enabled
+    entries_.clear();
+    sources_.clear();
+    maxLast_ = 0.;
+    maxTotal_ = 0.;
+    maximaDirty_ = false;
+  }
+}
+
+void ExecutionTimer::addSource(pqPipelineSource *source) {
+  if (enabled_)
+    this->attach(source);
+}
+
+void ExecutionTimer::removeSource(pqPipelineSource *source) {
+  this->detach(source);
+  auto it = entries_.find(source);
+  if (it == entries_.end())
+    return;
+  if (it->second.last >= maxLast_ || it->second.total >= maxTotal_) {
+    maximaDirty_ = true;
+  }
+  entries_.erase(it);
+}
+
+void ExecutionTimer::attach(pqPipelineSource *source) {
+  Entry &entry = entries_[source];
+  if (entry.algorithm)
+    return;
+  // the client side object is the algorithm itself in builtin sessions only
+  auto smproxy = source->getSourceProxy();
+  auto algorithm = smproxy ? vtkAlgorithm::SafeDownCast(smproxy->GetClientSideObject()) : nullptr;
+  if (!algorithm)
+    return;
+  entry.algorithm = algorithm;
+  entry.startTag = algorithm->AddObserver(vtkCommand::StartEvent, this, &ExecutionTimer::onStart);
+  entry.endTag = algorithm->AddObserver(vtkCommand::EndEvent, this, &ExecutionTimer::onEnd);
+  sources_[algorithm] = source;
+}
+
+void ExecutionTimer::detach(pqPipelineSource *source) {
+  auto it = entries_.find(source);
+  if (it == entries_.end())
+    return;
+  Entry &entry = it->second;
+  if (entry.algorithm) {
+    entry.algorithm->RemoveObserver(entry.startTag);
+    entry.algorithm->RemoveObserver(entry.endTag);
+    sources_.erase(entry.algorithm);
+  }
+  entry.algorithm = nullptr;
+  entry.running = false;
+}
+
+void ExecutionTimer::onStart(vtkObject *caller, unsigned long, void *) {
+  auto it = sources_.find(caller);
+  if (it == sources_.end())
+    return;
+  Entry &entry = entries_[it->second];
+  entry.start = Clock::now();
+  entry.running = true;
+}
+
+void ExecutionTimer::onEnd(vtkObject *caller, unsigned long, void *) {
+  auto it = sources_.find(caller);
+  if (it == sources_.end())
+    return;
+  pqPipelineSource *source = it->second;
+  Entry &entry = entries_[source];
+  if (!entry.running)
+    return;
+  entry.running = false;
+  const double previous = entry.last;
+  entry.last = std::chrono::duration<double>(Clock::now() - entry.start).count();
+  entry.total += entry.last;
+  entry.hasTime = true;
+  if (entry.last >= maxLast_) {
+    maxLast_ = entry.last;
+  } else if (previous >= maxLast_) {
+    maximaDirty_ = true;
+  }
+  maxTotal_ = std::max(maxTotal_, entry.total);
+  emit updated(source);
+}
+
+bool ExecutionTimer::hasTime(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() && it->second.hasTime;
+}
+
+double ExecutionTimer::lastTime(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() ? it->second.last : 0.;
+}
+
+double ExecutionTimer::totalTime(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() ? it->second.total : 0.;
+}
+
+double ExecutionTimer::maxLastTime() const {
+  if (maximaDirty_)
+    this->updateMaxima();
+  return maxLast_;
+}
+
+double ExecutionTimer::maxTotalTime() const {
+  if (maximaDirty_)
+    this->updateMaxima();
+  return maxTotal_;
+}
+
+void ExecutionTimer::updateMaxima() const {
+  maxLast_ = 0.;
+  maxTotal_ = 0.;
+  for (const auto &kv : entries_) {
+    maxLast_ = std::max(maxLast_, kv.second.last);
+    maxTotal_ = std::max(maxTotal_, kv.second.total);
+  }
+  maximaDirty_ = false;
+}
+
+}
@@ -0,0 +1,78 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_EXECUTIONTIMER_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_EXECUTIONTIMER_H_
+
+#include <vtkWeakPointer.h>
+
+#include <QObject>
+
+#include <chrono>
+#include <unordered_map>
+
+class pqPipelineSource;
+class vtkObject;
+
+namespace ParaViewNetworkEditor {
+
+// Records the wall time of each execution of the sources' algorithms from their StartEvent and EndEvent.
+// Observers are only attached while the timer is enabled, so there is no overhead when no one looks at the
+// timings. Only builtin sessions expose the algorithms to the client; in client/server sessions nothing is
+// recorded.
+class ExecutionTimer : public QObject {
+ Q_OBJECT
+ public:
+  static ExecutionTimer *instance();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return enabled_; }
+
+  // True if the source executed at least once while the timer was enabled.
+  bool hasTime(pqPipelineSource *source) const;
+  // Time of the last execution in seconds.
+  double lastTime(pqPipelineSource *source) const;
+  // Accumulated time of all executions in seconds, since the timer was enabled.
+  double totalTime(pqPipelineSource *source) const;
+  // Largest times of all sources, kept up to date as times are recorded so that painting does not scan the sources.
+  double maxLastTime() const;
+  double maxTotalTime() const;
+
+ signals:
+  // Emitted after the source finished executing.
+  void updated(pqPipelineSource *source);
+
+ private:
+  ExecutionTimer();
+  ~ExecutionTimer() override;
+
+  void addSource(pqPipelineSource *source);
+  void removeSource(pqPipelineSource *source);
+  void attach(pqPipelineSource *source);
+  void detach(pqPipelineSource *source);
+
+  void onStart(vtkObject *caller, unsigned long, void *);
+  void onEnd(vtkObject *caller, unsigned long, void *);
+
+  using Clock = std::chrono::steady_clock;
+  struct Entry {
+    vtkWeakPointer<vtkObject> algorithm;
+    unsigned long startTag = 0;
+    unsigned long endTag = 0;
+    Clock::time_point start;
+    bool running = false;
+    bool hasTime = false;
+    double last = 0.;
+    double total = 0.;
+  };
+  std::unordered_map<pqPipelineSource *, Entry> entries_;
+  std::unordered_map<vtkObject *, pqPipelineSource *> sources_;
+  bool enabled_ = false;
+
+  // the maxima are only rescanned after the source that held one got a smaller time or was removed
+  mutable double maxLast_ = 0.;
+  mutable double maxTotal_ = 0.;
+  mutable bool maximaDirty_ = false;
+  void updateMaxima() const;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_EXECUTIONTIMER_H_
@@ -0,0 +1,83 @@
+#include "InteractionRecorder.h"
+
+#include <QGraphicsView>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+
+namespace ParaViewNetworkEditor {
+
+InteractionRecorder::InteractionRecorder(QGraphicsView *view)
+    : QObject(view), view_(view) {
+  // mouse and wheel events go to the viewport, key events to the view
+  view_->installEventFilter(this);
+  view_->viewport()->installEventFilter(this);
+}
+
+InteractionRecorder::~InteractionRecorder() = default;
+
+void InteractionRecorder::start() {
+  trace_ = interaction_trace::Trace();
+  trace_.view_size = view_->viewport()->size();
+  trace_.transform = view_->transform();
+  trace_.center = view_->mapToScene(view_->viewport()->rect().center());
+  timer_.start();
+  recording_ = true;
+}
+
+void InteractionRecorder::stop() {
+  recording_ = false;
+}
+
+bool InteractionRecorder::eventFilter(QObject *watched, QEvent *event) {
+  if (!recording_)
+    return false;
+  interaction_trace::Event recorded;
+  recorded.type = event->type();
+  switch (event->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove: {
+      if (watched != view_->viewport())
+        return false;
+      auto mouse_event = static_cast<QMouseEvent *>(event);
+      recorded.pos = view_->mapToScene(mouse_event->pos());
+      recorded.button = static_cast<int>(mouse_event->button());
+      recorded.buttons = static_cast<int>(mouse_event->buttons());
+      recorded.modifiers = static_cast<int>(mouse_event->modifiers());
+      break;
+    }
+    case QEvent::Wheel: {
+      if (watched != view_->viewport())
+        return false;
+      auto wheel_event = static_cast<QWheelEvent *>(event);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+      recorded.pos = view_->mapToScene(wheel_event->position().toPoint());
+#else
+      recorded.pos = view_->mapToScene(wheel_event->pos());
+#endif
+      recorded.buttons = static_cast<int>(wheel_event->buttons());
+      recorded.modifiers = static_cast<int>(wheel_event->modifiers());
+      recorded.angle_delta = wheel_event->angleDelta();
+      break;
+    }
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease: {
+      if (watched != view_)
+        return false;
+      auto key_event = static_cast<QKeyEvent *>(event);
+      recorded.key = key_event->key();
+      recorded.text = key_event->text();
+      recorded.modifiers = static_cast<int>(key_event->modifiers());
+      break;
+    }
+    default:
+      return false;
+  }
+  recorded.time = timer_.nsecsElapsed() * 1e-6;
+  trace_.events.push_back(recorded);
+  return false;
+}
+
+}
@@ -0,0 +1,38 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_INTERACTIONRECORDER_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_INTERACTIONRECORDER_H_
+
+#include "interaction_trace.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+
+class QGraphicsView;
+
+namespace ParaViewNetworkEditor {
+
+// Records the mouse, wheel and key events of a view while recording is on. The trace can be replayed with
+// pvnetworkreplay on the same state to turn an interaction sequence into a repeatable benchmark.
+class InteractionRecorder : public QObject {
+ public:
+  explicit InteractionRecorder(QGraphicsView *view);
+  ~InteractionRecorder() override;
+
+  // Starts a new trace, discarding the previous one.
+  void start();
+  void stop();
+  bool isRecording() const { return recording_; }
+  const interaction_trace::Trace &trace() const { return trace_; }
+
+ protected:
+  bool eventFilter(QObject *watched, QEvent *event) override;
+
+ private:
+  QGraphicsView *view_;
+  bool recording_ = false;
+  QElapsedTimer timer_;
+  interaction_trace::Trace trace_;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_INTERACTIONRECORDER_H_
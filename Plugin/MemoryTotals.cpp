@@ -0,0 +1,272 @@
+#include "MemoryTotals.h"
+#include "DataInformationCache.h"
+#include "utilpq.h"
+
+#include <vtkLogger.h>
+#include <vtkPVDataInformation.h>
+
+#include <pqApplicationCore.h>
+#include <pqOutputPort.h>
+#include <pqPipelineFilter.h>
+#include <pqPipelineSource.h>
+#include <pqServerManagerModel.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+
+MemoryTotals *MemoryTotals::instance() {
+  static MemoryTotals *totals = new MemoryTotals();
+  return totals;
+}
+
+MemoryTotals::MemoryTotals()
+    : QObject(pqApplicationCore::instance()) {
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  connect(smModel, &pqServerManagerModel::sourceAdded, this, &MemoryTotals::addSource);
+  connect(smModel, &pqServerManagerModel::preSourceRemoved, this, &MemoryTotals::removeSource);
+  connect(smModel,
+          static_cast<void (pqServerManagerModel::*)(pqPipelineSource*, pqPipelineSource*, int)>(&pqServerManagerModel::connectionAdded),
+          this, [this](pqPipelineSource *source, pqPipelineSource *consumer, int) {
+            this->onConnectionChanged(source, consumer, true);
+          });
+  connect(smModel,
+          static_cast<void (pqServerManagerModel::*)(pqPipelineSource*, pqPipelineSource*, int)>(&pqServerManagerModel::connectionRemoved),
+          this, [this](pqPipelineSource *source, pqPipelineSource *consumer, int) {
+            this->onConnectionChanged(source, consumer, false);
+          });
+  connect(DataInformationCache::instance(), &DataInformationCache::updated,
+          this, &MemoryTotals::onDataInformationUpdated);
+}
+
+MemoryTotals::~MemoryTotals() = default;
+
+void MemoryTotals::setEnabled(bool enabled) {
+  if (enabled_ == enabled)
+    return;
+  enabled_ = enabled;
+  entries_.clear();
+  maxOwn_ = 0.;
+  maxBranch_ = 0.;
+  maximaDirty_ = false;
+  if (!enabled)
+    return;
+  for (pqPipelineSource *source : utilpq::get_sources()) {
+    entries_[source].own = this->gatheredMemory(source);
+    // requests the ports that were not gathered yet
+    for (pqOutputPort *port : source->getOutputPorts()) {
+      DataInformationCache::instance()->get(port);
+    }
+  }
+  this->recomputeBranches();
+  emit updated();
+}
+
+void MemoryTotals::addSource(pqPipelineSource *source) {
+  if (!enabled_ || entries_.count(source))
+    return;
+  // connections of the new source may have been announced before the source itself, so its branch is counted
+  // like any other and its own memory is added to everything upstream of it
+  Entry &entry = entries_[source];
+  this->setBranch(entry, this->sumOwn(this->downstream(source)));
+  this->setOwn(source, this->gatheredMemory(source));
+  // requests the ports that were not gathered yet
+  for (pqOutputPort *port : source->getOutputPorts()) {
+    DataInformationCache::instance()->get(port);
+  }
+  emit updated();
+}
+
+void MemoryTotals::removeSource(pqPipelineSource *source) {
+  if (!enabled_ || !entries_.count(source))
+    return;
+  this->setOwn(source, 0.);
+  const Entry &entry = entries_[source];
+  if (entry.branch >= maxBranch_) {
+    maximaDirty_ = true;
+  }
+  entries_.erase(source);
+  emit updated();
+}
+
+void MemoryTotals::onConnectionChanged(pqPipelineSource *source, pqPipelineSource *consumer, bool added) {
+  auto filter = qobject_cast<pqPipelineFilter *>(consumer);
+  if (!enabled_ || !filter)
+    return;
+  vtkLogScopeF(8, "MemoryTotals::onConnectionChanged");
+  // another connection between the two sources leaves everything reachable as it was
+  int connections = 0;
+  for (pqOutputPort *port : filter->getAllInputs()) {
+    if (port->getSource() == source)
+      ++connections;
+  }
+  if (connections != (added ? 1 : 0))
+    return;
+
+  const std::vector<pqPipelineSource *> branch = this->downstream(consumer);
+  const std::unordered_set<pqPipelineSource *> in_branch(branch.begin(), branch.end());
+  bool merged = false;
+  for (pqPipelineSource *current : branch) {
+    auto current_filter = qobject_cast<pqPipelineFilter *>(current);
+    if (!current_filter)
+      continue;
+    for (pqPipelineSource *input : current_filter->getInputs()) {
+      if (!in_branch.count(input) && !(input == source && current == consumer))
+        merged = true;
+    }
+  }
+
+  const std::vector<pqPipelineSource *> sources = this->upstream(source);
+  if (!merged) {
+    // the branch is reached only through this connection, so every upstream source gains or loses all of it
+    const double memory = this->sumOwn(branch);
+    this->addToBranches(sources, added ? memory : -memory);
+  } else {
+    // sources upstream may reach parts of the branch on other paths as well, they are recounted
+    for (pqPipelineSource *current : sources) {
+      auto entry = entries_.find(current);
+      if (entry != entries_.end())
+        this->setBranch(entry->second, this->sumOwn(this->downstream(current)));
+    }
+  }
+  emit updated();
+}
+
+double MemoryTotals::gatheredMemory(pqPipelineSource *source) const {
+  double memory = 0.;
+  auto cache = DataInformationCache::instance();
+  for (pqOutputPort *port : source->getOutputPorts()) {
+    if (!cache->isValid(port))
+      continue;
+    if (vtkPVDataInformation *info = cache->get(port))
+      memory += info->GetMemorySize();
+  }
+  return memory;
+}
+
+void MemoryTotals::onDataInformationUpdated(const QList<pqOutputPort *> &ports) {
+  if (!enabled_)
+    return;
+  vtkLogScopeF(8, "MemoryTotals::onDataInformationUpdated");
+  std::unordered_set<pqPipelineSource *> sources;
+  for (pqOutputPort *port : ports) {
+    sources.insert(port->getSource());
+  }
+  for (pqPipelineSource *source : sources) {
+    if (entries_.count(source))
+      this->setOwn(source, this->gatheredMemory(source));
+  }
+  emit updated();
+}
+
+std::vector<pqPipelineSource *> MemoryTotals::downstream(pqPipelineSource *source) const {
+  std::unordered_set<pqPipelineSource *> visited{source};
+  std::vector<pqPipelineSource *> sources{source};
+  for (size_t i = 0; i < sources.size(); ++i) {
+    for (pqPipelineSource *consumer : sources[i]->getAllConsumers()) {
+      if (visited.insert(consumer).second)
+        sources.push_back(consumer);
+    }
+  }
+  return sources;
+}
+
+std::vector<pqPipelineSource *> MemoryTotals::upstream(pqPipelineSource *source) const {
+  std::unordered_set<pqPipelineSource *> visited{source};
+  std::vector<pqPipelineSource *> sources{source};
+  for (size_t i = 0; i < sources.size(); ++i) {
+    auto filter = qobject_cast<pqPipelineFilter *>(sources[i]);
+    if (!filter)
+      continue;
+    for (pqPipelineSource *input : filter->getInputs()) {
+      if (visited.insert(input).second)
+        sources.push_back(input);
+    }
+  }
+  return sources;
+}
+
+double MemoryTotals::sumOwn(const std::vector<pqPipelineSource *> &sources) const {
+  double memory = 0.;
+  for (pqPipelineSource *source : sources) {
+    auto entry = entries_.find(source);
+    if (entry != entries_.end())
+      memory += entry->second.own;
+  }
+  return memory;
+}
+
+void MemoryTotals::setOwn(pqPipelineSource *source, double own) {
+  Entry &entry = entries_[source];
+  const double delta = own - entry.own;
+  this->track(maxOwn_, entry.own, own);
+  entry.own = own;
+  // the source is part of the branch of itself and of each upstream source, each counted once
+  if (delta != 0.)
+    this->addToBranches(this->upstream(source), delta);
+}
+
+void MemoryTotals::addToBranches(const std::vector<pqPipelineSource *> &sources, double delta) {
+  for (pqPipelineSource *source : sources) {
+    auto entry = entries_.find(source);
+    if (entry != entries_.end())
+      this->setBranch(entry->second, entry->second.branch + delta);
+  }
+}
+
+void MemoryTotals::setBranch(Entry &entry, double branch) {
+  this->track(maxBranch_, entry.branch, branch);
+  entry.branch = branch;
+}
+
+void MemoryTotals::recomputeBranches() {
+  vtkLogScopeF(8, "MemoryTotals::recomputeBranches");
+  for (auto &kv : entries_) {
+    kv.second.branch = this->sumOwn(this->downstream(kv.first));
+  }
+  maximaDirty_ = true;
+}
+
+void MemoryTotals::track(double &max, double old, double value) {
+  if (value >= max) {
+    max = value;
+  } else if (old >= max) {
+    maximaDirty_ = true;
+  }
+}
+
+void MemoryTotals::updateMaxima() const {
+  maxOwn_ = 0.;
+  maxBranch_ = 0.;
+  for (const auto &kv : entries_) {
+    maxOwn_ = std::max(maxOwn_, kv.second.own);
+    maxBranch_ = std::max(maxBranch_, kv.second.branch);
+  }
+  maximaDirty_ = false;
+}
+
+double MemoryTotals::ownMemory(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() ? it->second.own : 0.;
+}
+
+double MemoryTotals::branchMemory(pqPipelineSource *source) const {
+  auto it = entries_.find(source);
+  return it != entries_.end() ? it->second.branch : 0.;
+}
+
+double MemoryTotals::maxOwnMemory() const {
+  if (maximaDirty_)
+    this->updateMaxima();
+  return maxOwn_;
+}
+
+double MemoryTotals::maxBranchMemory() const {
+  if (maximaDirty_)
+    this->updateMaxima();
+  return maxBranch_;
+}
+
+}
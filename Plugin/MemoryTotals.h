@@ -0,0 +1,75 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_MEMORYTOTALS_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_MEMORYTOTALS_H_
+
+#include <QObject>
+
+#include <unordered_map>
+#include <vector>
+
+class pqOutputPort;
+class pqPipelineSource;
+
+namespace ParaViewNetworkEditor {
+
+// Memory held by the outputs of each source and by each source together with everything downstream of it.
+// The sizes are taken from the DataInformationCache. Counts every downstream source once, also where branches
+// merge. Totals are kept up to date incrementally: when a port is gathered again, the difference is added to the
+// source and its upstream sources. When a connection is added or removed and the branch below it is reached only
+// through that connection, its total is added to or subtracted from the sources upstream of the connection; only
+// where branches merge are the upstream totals recounted. Everything is counted from scratch only when enabled.
+class MemoryTotals : public QObject {
+ Q_OBJECT
+ public:
+  static MemoryTotals *instance();
+
+  // While enabled, the data information of all output ports is gathered and kept up to date.
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return enabled_; }
+
+  // Memory of the outputs of the source in KiB.
+  double ownMemory(pqPipelineSource *source) const;
+  // Memory of the outputs of the source and of all sources downstream of it in KiB.
+  double branchMemory(pqPipelineSource *source) const;
+  double maxOwnMemory() const;
+  double maxBranchMemory() const;
+
+ signals:
+  void updated();
+
+ private:
+  MemoryTotals();
+  ~MemoryTotals() override;
+
+  void addSource(pqPipelineSource *source);
+  void removeSource(pqPipelineSource *source);
+  void onConnectionChanged(pqPipelineSource *source, pqPipelineSource *consumer, bool added);
+  void onDataInformationUpdated(const QList<pqOutputPort *> &ports);
+  double gatheredMemory(pqPipelineSource *source) const;
+
+  struct Entry {
+    double own = 0.;
+    double branch = 0.;
+  };
+  // Sources reachable from the source through its consumers or inputs, including the source itself.
+  std::vector<pqPipelineSource *> downstream(pqPipelineSource *source) const;
+  std::vector<pqPipelineSource *> upstream(pqPipelineSource *source) const;
+  double sumOwn(const std::vector<pqPipelineSource *> &sources) const;
+  void setOwn(pqPipelineSource *source, double own);
+  void addToBranches(const std::vector<pqPipelineSource *> &sources, double delta);
+  void setBranch(Entry &entry, double branch);
+  void recomputeBranches();
+
+  std::unordered_map<pqPipelineSource *, Entry> entries_;
+  bool enabled_ = false;
+
+  // the maxima are only rescanned after the source that held one got a smaller value or was removed
+  mutable double maxOwn_ = 0.;
+  mutable double maxBranch_ = 0.;
+  mutable bool maximaDirty_ = false;
+  void track(double &max, double old, double value);
+  void updateMaxima() const;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_MEMORYTOTALS_H_
@@ -9,6 +9,16 @@
 #include "vtkPasteStateLoader.h"
 #include "vtkPasteProxyLocator.h"
 #include "StickyNoteGraphicsItem.h"
+#include "vtkNodeGeometryUndoElement.h"
+#include "PipelineMimeData.h"
+#include "DataInformationCache.h"
+#include "ExecutionTimer.h"
+#include "ExecutionProgress.h"
+#include "MemoryTotals.h"
+#include "node_layout.h"
+#include "pipeline_analysis.h"
+#include "chrome_trace.h"
+#include "perf_counters.h"
 
 #ifdef ENABLE_GRAPHVIZ
 # include "graph_layout.h"
@@ -20,9 +30,12 @@
 #include <vtkSMPropertyIterator.h>
 #include <vtkSMInputProperty.h>
 #include <vtkSMPropertyHelper.h>
+#include <vtkSMDoubleVectorProperty.h>
+#include <vtkSMIdTypeVectorProperty.h>
+#include <vtkSMIntVectorProperty.h>
+#include <vtkSMStringVectorProperty.h>
 #include <vtkSMSessionProxyManager.h>
 #include <vtkPVXMLElement.h>
-#include <vtkPVXMLParser.h>
 #include <vtkSMProxyManager.h>
 #include <vtkCollection.h>
 #include <vtkVersion.h>
@@ -32,14 +45,18 @@
 #include <vtkSMProxyLocator.h>
 #include <vtkSMProxySelectionModel.h>
 #include <vtkSMProxyDefinitionManager.h>
+#include <vtkSmartPointer.h>
 #include <vtkPVProxyDefinitionIterator.h>
 #include <vtkSMParaViewPipelineControllerWithRendering.h>
 
 #include <pqPipelineFilter.h>
 #include <pqPipelineSource.h>
+#include <pqOutputPort.h>
 #include <pqActiveObjects.h>
 #include <pqApplicationCore.h>
 #include <pqServerManagerModel.h>
+#include <pqServer.h>
+#include <pqView.h>
 #include <pqRepresentation.h>
 #include <pqDataRepresentation.h>
 #include <pqScalarBarVisibilityReaction.h>
@@ -54,6 +71,7 @@
 #include <pqDataRepresentation.h>
 #include <pqQuickLaunchDialog.h>
 #include <pqObjectBuilder.h>
+#include <pqFileDialog.h>
 #include <vtkPVConfig.h>
 
 #include <QGraphicsView>
@@ -63,18 +81,127 @@
 #include <QMimeData>
 #include <QApplication>
 #include <QClipboard>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMenuBar>
 #include <QMainWindow>
 #include <QScrollBar>
+#include <QTimer>
+#include <QToolTip>
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <cassert>
 
 namespace ParaViewNetworkEditor {
 
 const int NetworkEditor::gridSpacing_ = 25;
 
+namespace {
+
+// color ramp of the overlays, from the cheapest to the most expensive node
+const std::vector<std::pair<qreal, QColor>> &overlay_color_stops() {
+  static const std::vector<std::pair<qreal, QColor>> stops = {
+      {0.0, QColor("#2b4c7e")},
+      {0.4, QColor("#7a2f7a")},
+      {0.7, QColor("#c0392b")},
+      {1.0, QColor("#e67e22")},
+  };
+  return stops;
+}
+
+QColor overlay_color(qreal t) {
+  const auto &stops = overlay_color_stops();
+  t = std::max<qreal>(0., std::min<qreal>(1., t));
+  for (size_t i = 1; i < stops.size(); ++i) {
+    if (t > stops[i].first)
+      continue;
+    const qreal s = (t - stops[i - 1].first) / (stops[i].first - stops[i - 1].first);
+    const QColor &a = stops[i - 1].second;
+    const QColor &b = stops[i].second;
+    return QColor::fromRgbF(a.redF() + s * (b.redF() - a.redF()),
+                            a.greenF() + s * (b.greenF() - a.greenF()),
+                            a.blueF() + s * (b.blueF() - a.blueF()));
+  }
+  return stops.back().second;
+}
+
+QString format_seconds(double seconds) {
+  if (seconds < 1.)
+    return QString::number(seconds * 1000., 'f', 1) + " ms";
+  return QString::number(seconds, 'f', 2) + " s";
+}
+
+// Type and property values of a proxy, without its inputs. Proxies referenced by properties (e.g. the plane of a
+// clip) are compared by their own values, as every filter has its own instances.
+void append_proxy_signature(std::string &signature, vtkSMProxy *proxy, int depth) {
+  if (!proxy) {
+    signature += "null;";
+    return;
+  }
+  signature += proxy->GetXMLGroup();
+  signature += '/';
+  signature += proxy->GetXMLName();
+  signature += '{';
+  char number[32];
+  auto iter = vtkSmartPointer<vtkSMPropertyIterator>::Take(proxy->NewPropertyIterator());
+  for (iter->Begin(); !iter->IsAtEnd(); iter->Next()) {
+    vtkSMProperty *prop = iter->GetProperty();
+    if (!prop || prop->GetInformationOnly() || vtkSMInputProperty::SafeDownCast(prop))
+      continue;
+    signature += iter->GetKey();
+    signature += '=';
+    if (auto dvp = vtkSMDoubleVectorProperty::SafeDownCast(prop)) {
+      for (unsigned int i = 0; i < dvp->GetNumberOfElements(); ++i) {
+        std::snprintf(number, sizeof(number), "%.17g,", dvp->GetElement(i));
+        signature += number;
+      }
+    } else if (auto ivp = vtkSMIntVectorProperty::SafeDownCast(prop)) {
+      for (unsigned int i = 0; i < ivp->GetNumberOfElements(); ++i) {
+        signature += std::to_string(ivp->GetElement(i)) + ',';
+      }
+    } else if (auto idvp = vtkSMIdTypeVectorProperty::SafeDownCast(prop)) {
+      for (unsigned int i = 0; i < idvp->GetNumberOfElements(); ++i) {
+        signature += std::to_string(idvp->GetElement(i)) + ',';
+      }
+    } else if (auto svp = vtkSMStringVectorProperty::SafeDownCast(prop)) {
+      for (unsigned int i = 0; i < svp->GetNumberOfElements(); ++i) {
+        const char *value = svp->GetElement(i);
+        std::string str = value ? value : "";
+        signature += std::to_string(str.size()) + ':' + str + ',';
+      }
+    } else if (auto pp = vtkSMProxyProperty::SafeDownCast(prop)) {
+      for (unsigned int i = 0; i < pp->GetNumberOfProxies(); ++i) {
+        if (depth < 4) {
+          append_proxy_signature(signature, pp->GetProxy(i), depth + 1);
+        } else {
+          signature += std::to_string(pp->GetProxy(i) ? pp->GetProxy(i)->GetGlobalID() : 0) + ',';
+        }
+      }
+    }
+    signature += ';';
+  }
+  signature += '}';
+}
+
+QString format_kibibytes(double kib) {
+  if (kib < 1024.)
+    return QString::number(kib, 'f', 0) + " KB";
+  if (kib < 1024. * 1024.)
+    return QString::number(kib / 1024., 'f', 1) + " MB";
+  return QString::number(kib / (1024. * 1024.), 'f', 2) + " GB";
+}
+
+}
+
 NetworkEditor::NetworkEditor()
     : connectionDragHelper_{new ConnectionDragHelper(*this)} {
   // The default BSP tends to crash...
@@ -82,7 +209,7 @@ NetworkEditor::NetworkEditor()
   setSceneRect(QRectF());
 
   // add current sources
-  auto sources = utilpq::get_sources();
+  const auto &sources = utilpq::get_sources();
   for (pqPipelineSource *source: sources) {
     addSourceRepresentation(source);
   }
@@ -105,6 +232,7 @@ NetworkEditor::NetworkEditor()
             vtkLogScopeF(8, "pqActiveObjects::selectionChanged");
             if (updateSelection_)
               return;
+            perf_counters::increment(perf_counters::SELECTION_SYNCS_FROM_PARAVIEW);
             updateSelection_ = true;
             pqProxySelection selection_all = selection;
             for (pqServerManagerModelItem *proxy : selection) {
@@ -149,6 +277,10 @@ NetworkEditor::NetworkEditor()
   connect(smModel, &pqServerManagerModel::sourceRemoved, this, [this](pqPipelineSource *source) {
     vtkLog(5,  "removed source " << source->getSMName().toStdString());
     removeSourceRepresentation(source);
+    // without an undo stack, deleted sources never come back
+    if (!pqApplicationCore::instance()->getUndoStack()) {
+      node_layout::erase(source->getProxy()->GetGlobalID());
+    }
     // there is an assumption in ParaView that sources are not added or deleted during this event!
     // utilpq::collect_dummy_source();
   });
@@ -173,6 +305,27 @@ NetworkEditor::NetworkEditor()
             updateConnectionRepresentations(source, dest);
           });
 
+  // proxy ids are only unique within a session
+  connect(smModel, &pqServerManagerModel::serverRemoved, this, [](pqServer *) {
+    node_layout::clear();
+  });
+
+  // the node layout keeps the entries of deleted sources while undoing can bring them back
+  auto prune_node_layout = [](bool can_undo, const QString &, bool can_redo, const QString &) {
+    if (can_undo || can_redo)
+      return;
+    if (auto server = pqActiveObjects::instance().activeServer()) {
+      node_layout::prune(server->session());
+    }
+  };
+  auto watch_undo_stack = [this, prune_node_layout](pqUndoStack *undo_stack) {
+    if (undo_stack) {
+      connect(undo_stack, &pqUndoStack::stackChanged, this, prune_node_layout);
+    }
+  };
+  watch_undo_stack(pqApplicationCore::instance()->getUndoStack());
+  connect(pqApplicationCore::instance(), &pqApplicationCore::undoStackChanged, this, watch_undo_stack);
+
   connect(smModel, &pqServerManagerModel::representationAdded, this, [this](pqRepresentation *rep) {
     vtkLog(5,   "added representation " << rep->getSMName().toStdString());
     if (auto data_repr = dynamic_cast<pqDataRepresentation *>(rep)) {
@@ -187,6 +340,36 @@ NetworkEditor::NetworkEditor()
     vtkLog(5,   "removed representation " << rep->getSMName().toStdString());
   });
 
+  // port colors and tooltips depend on data information, which is gathered in batches
+  connect(DataInformationCache::instance(), &DataInformationCache::updated, this, [this]() {
+    this->update();
+    if (refreshToolTip_) {
+      refreshToolTip_ = false;
+      if (QToolTip::isVisible()) {
+        QGraphicsSceneHelpEvent help_event;
+        help_event.setScenePos(lastHelpScenePos_);
+        help_event.setScreenPos(lastHelpScreenPos_);
+        this->helpEvent(&help_event);
+      }
+    }
+  });
+
+  // the overlay is normalized by the most expensive source, so all nodes may change color
+  connect(ExecutionTimer::instance(), &ExecutionTimer::updated, this, [this](pqPipelineSource *) {
+    if (overlayMode_ == OVERLAY_LAST_EXECUTION_TIME || overlayMode_ == OVERLAY_TOTAL_EXECUTION_TIME)
+      this->update();
+  });
+  // progress is throttled by ExecutionProgress, only the executing node is repainted
+  connect(ExecutionProgress::instance(), &ExecutionProgress::changed, this, [this](pqPipelineSource *source) {
+    auto it = sourceGraphicsItems_.find(source);
+    if (it != sourceGraphicsItems_.end())
+      it->second->update();
+  });
+  connect(MemoryTotals::instance(), &MemoryTotals::updated, this, [this]() {
+    if (overlayMode_ == OVERLAY_MEMORY || overlayMode_ == OVERLAY_BRANCH_MEMORY)
+      this->update();
+  });
+
   connect(smModel, &pqServerManagerModel::modifiedStateChanged, this, [this](pqServerManagerModelItem *item) {
     auto source = qobject_cast<pqPipelineSource *>(item);
     if (!source)
@@ -203,10 +386,15 @@ NetworkEditor::NetworkEditor()
         auto settings = this->getGlobalOptions();
         if (!settings)
           return;
+        node_layout::load(settings, locator);
+        this->updateSourcePositions();
+        this->updateSceneSize();
+        this->scheduleLayoutSave();
         std::vector<double> M = vtkSMPropertyHelper(settings, "Transform").GetDoubleArray();
         int sx = vtkSMPropertyHelper(settings, "Scroll").GetAsInt(0);
         int sy = vtkSMPropertyHelper(settings, "Scroll").GetAsInt(1);
-        if (M.size() == 9) {
+        // without a view, e.g. when exporting diagrams headless, there is no transform to restore
+        if (M.size() == 9 && !this->views().empty()) {
           QTransform transform(M[0], M[1], M[2], M[3], M[4], M[5], M[6], M[7], M[8]);
           this->views().front()->setTransform(transform);
           this->views().front()->verticalScrollBar()->setValue(sx);
@@ -216,11 +404,7 @@ NetworkEditor::NetworkEditor()
   );
 
 
-
-  // undo/redo may change node positions
-  pqUndoStack *undo_stack = pqApplicationCore::instance()->getUndoStack();
-  connect(undo_stack, &pqUndoStack::undone, this, &NetworkEditor::updateSourcePositions);
-  connect(undo_stack, &pqUndoStack::redone, this, &NetworkEditor::updateSourcePositions);
+  // node moves are undone by vtkNodeGeometryUndoElement, which repositions the affected nodes itself
 
   QAction *showSBAction = new QAction(this);
   connect(showSBAction, &QAction::toggled, this, [this](bool) { this->update(); });
@@ -267,6 +451,10 @@ vtkSMProxy* NetworkEditor::getGlobalOptions() {
   return settings;
 }
 
+void NetworkEditor::refreshToolTipOnDataInformation() {
+  refreshToolTip_ = true;
+}
+
 void NetworkEditor::storeTransform(const QTransform& transform, int sx, int sy) {
   std::vector<double> M {
       transform.m11(), transform.m12(), transform.m13(),
@@ -315,18 +503,9 @@ void NetworkEditor::drawBackground(QPainter *painter, const QRectF &rect) {
   painter->restore();
 }
 
-void NetworkEditor::drawForeground(QPainter *painter, const QRectF &rect) {
-  // For testing purposes only. Draw bounding rects around all graphics items
-  if (false) {
-    QList<QGraphicsItem *> items = QGraphicsScene::items(Qt::DescendingOrder);
-    painter->setPen(Qt::magenta);
-    for (QList<QGraphicsItem *>::iterator it = items.begin(); it != items.end(); ++it) {
-      QRectF br = (*it)->sceneBoundingRect();
-      painter->drawRect(br);
-    }
-    painter->setPen(Qt::red);
-    painter->drawRect(QGraphicsScene::itemsBoundingRect());
-  }
+void NetworkEditor::setPerformanceHud(bool enabled) {
+  performanceHud_ = enabled;
+  this->update();
 }
 
 void NetworkEditor::addSourceRepresentation(pqPipelineSource *source) {
@@ -341,11 +520,7 @@ void NetworkEditor::addSourceRepresentation(pqPipelineSource *source) {
   }
 
   QPointF pos;
-  auto proxy = source->getProxy();
-  if (proxy->HasAnnotation("Node.x") && source->getProxy()->HasAnnotation("Node.y")) {
-    pos.setX(std::stof(proxy->GetAnnotation("Node.x")));
-    pos.setY(std::stof(proxy->GetAnnotation("Node.y")));
-  } else {
+  if (!node_layout::get_position(source->getProxy(), pos)) {
     if (addSourceAtMousePos_) {
       pos = lastMousePos_;
     } else {
@@ -355,13 +530,13 @@ void NetworkEditor::addSourceRepresentation(pqPipelineSource *source) {
     pos.setX(pos.x() + SourceGraphicsItem::size_.width() / 2.);
     pos.setY(pos.y() + SourceGraphicsItem::size_.height() / 2.);
   }
-  proxy->SetAnnotation("Node.x", std::to_string(pos.x()).c_str());
-  proxy->SetAnnotation("Node.y", std::to_string(pos.y()).c_str());
+  sourceGraphicsItem->storePosition(pos);
   sourceGraphicsItem->setPos(snapToGrid(pos));
 
   sourceGraphicsItems_[source] = sourceGraphicsItem;
   this->addItem(sourceGraphicsItem);
   updateSceneSize();
+  scheduleLayoutSave();
 
   if (addSourceToSelection_) {
     sourceGraphicsItem->setSelected(true);
@@ -400,6 +575,7 @@ void NetworkEditor::removeSourceRepresentation(pqPipelineSource *source) {
     connectionGraphicsItems_.erase(std::make_tuple(src, source));
   }
 
+  highlights_.erase(source);
   auto it = sourceGraphicsItems_.find(source);
   if (it == sourceGraphicsItems_.end())
     return;
@@ -407,9 +583,11 @@ void NetworkEditor::removeSourceRepresentation(pqPipelineSource *source) {
   delete it->second;
   sourceGraphicsItems_.erase(it);
   updateSceneSize();
+  scheduleLayoutSave();
 }
 
 void NetworkEditor::updateConnectionRepresentations(pqPipelineSource *source, pqPipelineSource *dest) {
+  vtkLogScopeFunction(8);
   if ((this->sourceGraphicsItems_.count(source) <= 0) || (this->sourceGraphicsItems_.count(dest) <= 0))
     return;
 
@@ -505,6 +683,8 @@ void NetworkEditor::contextMenuEvent(QGraphicsSceneContextMenuEvent *e) {
           source->setSelected(true);
           source->editIdentifier();
         });
+        auto update_upstream = menu.addAction(tr("Update Up To Here"));
+        connect(update_upstream, &QAction::triggered, this, &NetworkEditor::updateSelectedUpstream);
       }
       break;
     }
@@ -537,6 +717,50 @@ void NetworkEditor::contextMenuEvent(QGraphicsSceneContextMenuEvent *e) {
   auto delete_action = menu.addAction(tr("Delete"));
   connect(delete_action, &QAction::triggered, this, &NetworkEditor::deleteSelected);
 
+  menu.addSeparator();
+  auto analysis_menu = menu.addMenu(tr("Analysis"));
+  auto critical_path = analysis_menu->addAction(tr("Highlight Critical Path"));
+  connect(critical_path, &QAction::triggered, this, &NetworkEditor::highlightCriticalPath);
+  auto export_critical_paths = analysis_menu->addAction(tr("Export Critical Paths..."));
+  connect(export_critical_paths, &QAction::triggered, this, [this]() {
+    this->exportCriticalPaths("");
+  });
+  analysis_menu->addSeparator();
+  auto dead_branches = analysis_menu->addAction(tr("Highlight Dead Branches"));
+  connect(dead_branches, &QAction::triggered, this, &NetworkEditor::highlightDeadBranches);
+  auto select_dead_branches = analysis_menu->addAction(tr("Select Dead Branches"));
+  connect(select_dead_branches, &QAction::triggered, this, &NetworkEditor::selectDeadBranches);
+  auto delete_dead_branches = analysis_menu->addAction(tr("Delete Dead Branches"));
+  connect(delete_dead_branches, &QAction::triggered, this, &NetworkEditor::deleteDeadBranches);
+  analysis_menu->addSeparator();
+  auto duplicates = analysis_menu->addAction(tr("Highlight Duplicates"));
+  connect(duplicates, &QAction::triggered, this, &NetworkEditor::highlightDuplicates);
+  auto merge_duplicates = analysis_menu->addAction(tr("Merge Duplicates"));
+  connect(merge_duplicates, &QAction::triggered, this, &NetworkEditor::mergeDuplicates);
+  analysis_menu->addSeparator();
+  auto clear_highlights = analysis_menu->addAction(tr("Clear Highlights"));
+  clear_highlights->setEnabled(!highlights_.empty());
+  connect(clear_highlights, &QAction::triggered, this, &NetworkEditor::clearHighlights);
+  analysis_menu->addSeparator();
+  auto performance_hud = analysis_menu->addAction(tr("Performance HUD"));
+  performance_hud->setCheckable(true);
+  performance_hud->setChecked(performanceHud_);
+  connect(performance_hud, &QAction::toggled, this, &NetworkEditor::setPerformanceHud);
+  auto record_trace = analysis_menu->addAction(tr("Record Trace"));
+  record_trace->setCheckable(true);
+  record_trace->setChecked(chrome_trace::recording());
+  connect(record_trace, &QAction::toggled, this, [](bool checked) {
+    if (checked) {
+      chrome_trace::start();
+    } else {
+      chrome_trace::stop();
+    }
+  });
+  auto export_trace = analysis_menu->addAction(tr("Save Trace..."));
+  connect(export_trace, &QAction::triggered, this, [this]() {
+    this->exportTrace("");
+  });
+
   menu.addSeparator();
   auto copy = menu.addAction(tr("Copy"));
   connect(copy, &QAction::triggered, this, &NetworkEditor::copy);
@@ -566,11 +790,12 @@ void NetworkEditor::onSelectionChanged() {
   if (updateSelection_)
     return;
 
-  if (mouseDown_ || !this->views().first()->rubberBandRect().isEmpty())
+  if (mouseDown_ || (!this->views().empty() && !this->views().first()->rubberBandRect().isEmpty()))
     return;
 
   {
     vtkLogScopeF(8, "Synchronize with ParaView selection");
+    perf_counters::increment(perf_counters::SELECTION_SYNCS_TO_PARAVIEW);
 
     pqOutputPort* current_active_port = pqActiveObjects::instance().activePort();
     pqPipelineSource* current_active_port_source = nullptr;
@@ -663,14 +888,14 @@ void NetworkEditor::mouseReleaseEvent(QGraphicsSceneMouseEvent *e) {
   lastMousePos_ = e->scenePos();
 
   // snap selected sources to grid and store position in proxies
-  BEGIN_UNDO_SET("Move Nodes");
+  auto undo_element = vtkSmartPointer<vtkNodeGeometryUndoElement>::New();
   for (auto item : this->selectedItems()) {
     if (auto source = qgraphicsitem_cast<SourceGraphicsItem *>(item)) {
       source->setPos(snapToGrid(item->scenePos()));
-      source->storePosition();
+      this->storePosition(source, undo_element);
     }
   }
-  END_UNDO_SET();
+  this->addUndoElement("Move Nodes", undo_element);
   if (activeSourceItem_) {
     updateSceneSize();
     activeSourceItem_ = nullptr;
@@ -694,6 +919,9 @@ void NetworkEditor::mouseMoveEvent(QGraphicsSceneMouseEvent *e) {
 }
 
 void NetworkEditor::helpEvent(QGraphicsSceneHelpEvent *e) {
+  refreshToolTip_ = false;
+  lastHelpScenePos_ = e->scenePos();
+  lastHelpScreenPos_ = e->screenPos();
   QList<QGraphicsItem *> graphicsItems = items(e->scenePos(), Qt::IntersectsItemShape, Qt::DescendingOrder);
   for (auto item : graphicsItems) {
     if (auto editor_item = dynamic_cast<EditorGraphicsItem*>(item)) {
@@ -705,6 +933,7 @@ void NetworkEditor::helpEvent(QGraphicsSceneHelpEvent *e) {
 }
 
 void NetworkEditor::copy() {
+  vtkLogScopeFunction(8);
   // this creates a minimal statefile from the selected items
   // see implementation of vtkSMSessionProxyManager::AddInternalState
 
@@ -741,7 +970,8 @@ void NetworkEditor::copy() {
     if (auto source = source_item->getSource()) {
       vtkSMProxy *proxy = source->getProxy();
       collections["sources"].emplace_back(std::make_tuple(source->getSMName().toStdString(), proxy));
-      proxy->SaveXMLState(rootElement);
+      // the node layout table is not part of the copied state, so pass the geometry along as annotations
+      node_layout::write_annotations(proxy, proxy->SaveXMLState(rootElement));
       proxy_ids.insert(proxy->GetGlobalID());
 
       // collect input proxies
@@ -842,13 +1072,8 @@ void NetworkEditor::copy() {
 
   state->AddNestedElement(rootElement);
 
-  std::stringstream ss;
-  state->PrintXML(ss, vtkIndent());
-  std::string str = ss.str();
-
-  QByteArray data(str.c_str(), str.length());
-  auto mimedata = std::make_unique<QMimeData>();
-  mimedata->setData(QString("text/plain"), data);
+  // encoded lazily, when the clipboard contents are requested
+  auto mimedata = std::make_unique<PipelineMimeData>(state);
   QApplication::clipboard()->setMimeData(mimedata.release());
 }
 
@@ -866,16 +1091,198 @@ void NetworkEditor::setPasteMode(int mode_index) {
   }
 }
 
-void NetworkEditor::paste(float x, float y, bool keep_connections) {
-  auto clipboard = QApplication::clipboard();
-  std::string text = clipboard->text().toStdString();
-  auto parser = vtkSmartPointer<vtkPVXMLParser>::New();
-  if (!parser->Parse(text.c_str())) {
-    vtkLog(ERROR, "Encountered exception during parsing clipboard contents:\n" + text);
+void NetworkEditor::setOverlayMode(int mode_index) {
+  switch (mode_index) {
+    case 1:
+      overlayMode_ = OVERLAY_LAST_EXECUTION_TIME;
+      break;
+    case 2:
+      overlayMode_ = OVERLAY_TOTAL_EXECUTION_TIME;
+      break;
+    case 3:
+      overlayMode_ = OVERLAY_MEMORY;
+      break;
+    case 4:
+      overlayMode_ = OVERLAY_BRANCH_MEMORY;
+      break;
+    case 0:
+    default:
+      overlayMode_ = OVERLAY_NONE;
+  }
+  ExecutionTimer::instance()->setEnabled(
+      overlayMode_ == OVERLAY_LAST_EXECUTION_TIME || overlayMode_ == OVERLAY_TOTAL_EXECUTION_TIME);
+  MemoryTotals::instance()->setEnabled(overlayMode_ == OVERLAY_MEMORY || overlayMode_ == OVERLAY_BRANCH_MEMORY);
+  this->update();
+}
+
+QColor NetworkEditor::overlayColor(pqPipelineSource *source) const {
+  auto timer = ExecutionTimer::instance();
+  switch (overlayMode_) {
+    case OVERLAY_LAST_EXECUTION_TIME: {
+      const double max = timer->maxLastTime();
+      if (!timer->hasTime(source) || max <= 0.)
+        return QColor();
+      return overlay_color(timer->lastTime(source) / max);
+    }
+    case OVERLAY_TOTAL_EXECUTION_TIME: {
+      const double max = timer->maxTotalTime();
+      if (!timer->hasTime(source) || max <= 0.)
+        return QColor();
+      return overlay_color(timer->totalTime(source) / max);
+    }
+    case OVERLAY_MEMORY: {
+      auto totals = MemoryTotals::instance();
+      const double max = totals->maxOwnMemory();
+      if (max <= 0.)
+        return QColor();
+      return overlay_color(totals->ownMemory(source) / max);
+    }
+    case OVERLAY_BRANCH_MEMORY: {
+      auto totals = MemoryTotals::instance();
+      const double max = totals->maxBranchMemory();
+      if (max <= 0.)
+        return QColor();
+      return overlay_color(totals->branchMemory(source) / max);
+    }
+    case OVERLAY_NONE:
+    default:
+      return QColor();
+  }
+}
+
+bool NetworkEditor::overlayLegend(QString &title, QString &max_label, QGradientStops &stops) const {
+  auto timer = ExecutionTimer::instance();
+  switch (overlayMode_) {
+    case OVERLAY_LAST_EXECUTION_TIME:
+      title = "Last execution time";
+      max_label = format_seconds(timer->maxLastTime());
+      break;
+    case OVERLAY_TOTAL_EXECUTION_TIME:
+      title = "Total execution time";
+      max_label = format_seconds(timer->maxTotalTime());
+      break;
+    case OVERLAY_MEMORY:
+      title = "Output memory";
+      max_label = format_kibibytes(MemoryTotals::instance()->maxOwnMemory());
+      break;
+    case OVERLAY_BRANCH_MEMORY:
+      title = "Memory of downstream branch";
+      max_label = format_kibibytes(MemoryTotals::instance()->maxBranchMemory());
+      break;
+    case OVERLAY_NONE:
+    default:
+      return false;
+  }
+  stops.clear();
+  for (const auto &stop : overlay_color_stops()) {
+    stops.append(QGradientStop(stop.first, stop.second));
+  }
+  return true;
+}
+
+namespace {
+
+// Elements of a pasted state that need to be rewritten, collected in a single traversal.
+struct PasteIndex {
+  // <Proxy value="id" output_port="n"/> elements of input properties, by referenced proxy id
+  std::unordered_map<vtkTypeUInt32, std::vector<vtkPVXMLElement *>> port_references;
+  // Node.x / Node.y annotations
+  std::vector<vtkPVXMLElement *> node_x, node_y;
+  // items of the "sources" proxy collection
+  std::vector<vtkPVXMLElement *> source_items;
+};
+
+void index_paste_state(vtkPVXMLElement *element, PasteIndex &index) {
+  const char *name = element->GetName();
+  if (!name)
     return;
+  if (std::strcmp(name, "Proxy") == 0) {
+    if (element->GetAttribute("output_port")) {
+      vtkTypeUInt32 id = std::atoi(element->GetAttributeOrEmpty("value"));
+      index.port_references[id].push_back(element);
+    }
+  } else if (std::strcmp(name, "Annotation") == 0) {
+    const char *key = element->GetAttributeOrEmpty("key");
+    if (std::strcmp(key, "Node.x") == 0) {
+      index.node_x.push_back(element);
+    } else if (std::strcmp(key, "Node.y") == 0) {
+      index.node_y.push_back(element);
+    }
+  } else if (std::strcmp(name, "ProxyCollection") == 0) {
+    if (element->GetAttributeOrEmpty("name") == std::string("sources")) {
+      for (unsigned int i = 0; i < element->GetNumberOfNestedElements(); ++i) {
+        index.source_items.push_back(element->GetNestedElement(i));
+      }
+    }
+  }
+  for (unsigned int i = 0; i < element->GetNumberOfNestedElements(); ++i) {
+    index_paste_state(element->GetNestedElement(i), index);
+  }
+}
+
+// Assigns unique source names for pasted sources. A colliding name gets the next free numeric suffix
+// (Slice -> Slice1, Slice3 -> Slice4, ...). Used suffixes are kept per prefix, with each occupied suffix
+// pointing to the next candidate, so that a free suffix is found in amortized constant time.
+class SourceNameIndex {
+ public:
+  void insert(const std::string &name) {
+    names_.insert(name);
+    std::string prefix;
+    long long number;
+    if (split(name, prefix, number) && std::to_string(number) == name.substr(prefix.length())) {
+      next_[prefix][number] = number + 1;
+    }
+  }
+
+  std::string unique(const std::string &name) {
+    if (names_.count(name) == 0) {
+      insert(name);
+      return name;
+    }
+    std::string prefix;
+    long long number;
+    split(name, prefix, number);
+    std::string new_name = prefix + std::to_string(find(next_[prefix], number + 1));
+    insert(new_name);
+    return new_name;
+  }
+
+ private:
+  // Splits the trailing digits off name. Returns false if there are none.
+  static bool split(const std::string &name, std::string &prefix, long long &number) {
+    size_t k = name.length();
+    while (k > 0 && std::isdigit(name[k - 1])) {
+      --k;
+    }
+    prefix = name.substr(0, k);
+    number = std::atoll(name.substr(k, 18).c_str());
+    return k < name.length() && name.length() - k <= 18;
+  }
+
+  // smallest suffix >= number that is not taken
+  static long long find(std::unordered_map<long long, long long> &next, long long number) {
+    long long free = number;
+    for (auto it = next.find(free); it != next.end(); it = next.find(free)) {
+      free = it->second;
+    }
+    // path compression
+    while (number != free) {
+      auto it = next.find(number);
+      number = it->second;
+      it->second = free;
+    }
+    return free;
   }
 
-  auto paraview_element = parser->GetRootElement();
+  std::unordered_set<std::string> names_;
+  std::unordered_map<std::string, std::unordered_map<long long, long long>> next_;
+};
+
+}
+
+void NetworkEditor::paste(float x, float y, bool keep_connections) {
+  vtkLogScopeFunction(8);
+  vtkSmartPointer<vtkPVXMLElement> paraview_element = PipelineMimeData::state(QApplication::clipboard()->mimeData());
   if (!paraview_element || std::string(paraview_element->GetName()) != "ParaView") {
     vtkLog(ERROR, "No <ParaView> element.");
     return;
@@ -891,21 +1298,25 @@ void NetworkEditor::paste(float x, float y, bool keep_connections) {
     return;
   }
 
+  PasteIndex index;
+  index_paste_state(paraview_element, index);
+
   pqServerManagerModel* smModel = pqApplicationCore::instance()->getServerManagerModel();
-  std::vector<pqPipelineSource*> pipeline_sources = utilpq::get_sources();
+  const std::vector<pqPipelineSource*> &pipeline_sources = utilpq::get_sources();
+  // first source (by id) of each type, for guessing references by type
+  std::unordered_map<std::string, pqPipelineSource *> sources_by_type;
+  if (keep_connections) {
+    for (pqPipelineSource *source : pipeline_sources) {
+      sources_by_type.emplace(source->getProxy()->GetXMLName(), source);
+    }
+  }
   // build a mapping between IDs in the state and sources in the pipeline
   std::map<vtkTypeUInt32, vtkSMProxy*> proxy_map;
   pqPipelineSource* dummy_source = utilpq::get_dummy_source();
-  vtkNew<vtkCollection> proxy_references;
-  references_element->GetElementsByName("Item", proxy_references);
 
-  // get elements that reference a proxy
-  auto proxy_elements = vtkSmartPointer<vtkCollection>::New();
-  parser->GetRootElement()->GetElementsByName("Proxy", proxy_elements);
-
-  for (int i = 0; i < proxy_references->GetNumberOfItems(); ++i) {
-    auto proxy_reference = vtkPVXMLElement::SafeDownCast(proxy_references->GetItemAsObject(i));
-    if (!proxy_reference)
+  for (unsigned int i = 0; i < references_element->GetNumberOfNestedElements(); ++i) {
+    vtkPVXMLElement *proxy_reference = references_element->GetNestedElement(i);
+    if (!proxy_reference->GetName() || std::strcmp(proxy_reference->GetName(), "Item") != 0)
       continue;
     vtkTypeUInt32 id = std::atoi(proxy_reference->GetAttributeOrEmpty("id"));
     std::string name = proxy_reference->GetAttributeOrEmpty("name");
@@ -942,13 +1353,12 @@ void NetworkEditor::paste(float x, float y, bool keep_connections) {
       }
       if (!proxy) {
         // find by type
-        for (pqPipelineSource *source : pipeline_sources) {
-          if (xmlname == source->getProxy()->GetXMLName()) {
-            proxy = source->getProxy();
-            vtkLog(5,
-                   "Guessed proxy by type: " << source->getSMName().toStdString() << " (" << proxy->GetGlobalID() << ").");
-            break;
-          }
+        auto it = sources_by_type.find(xmlname);
+        if (it != sources_by_type.end()) {
+          pqPipelineSource *source = it->second;
+          proxy = source->getProxy();
+          vtkLog(5,
+                 "Guessed proxy by type: " << source->getSMName().toStdString() << " (" << proxy->GetGlobalID() << ").");
         }
       }
     }
@@ -959,84 +1369,41 @@ void NetworkEditor::paste(float x, float y, bool keep_connections) {
       // if no proxy found, connect to dummy
       proxy_map[id] = dummy_source->getProxy();
       // set output port to 0 in state
-      for (int j = 0; j < proxy_elements->GetNumberOfItems(); ++j) {
-        auto proxy_element = vtkPVXMLElement::SafeDownCast(proxy_elements->GetItemAsObject(j));
-        if (!proxy_element)
-          continue;
-        if (!proxy_element->GetAttribute("output_port"))
-          continue;
-        vtkTypeUInt32 proxy_id = std::atoi(proxy_element->GetAttributeOrEmpty("value"));
-        if (proxy_id == id) {
+      auto it = index.port_references.find(id);
+      if (it != index.port_references.end()) {
+        for (vtkPVXMLElement *proxy_element : it->second) {
           proxy_element->SetAttribute("output_port", "0");
         }
       }
     }
   }
 
-
-  auto annotations = vtkSmartPointer<vtkCollection>::New();
-  parser->GetRootElement()->GetElementsByName("Annotation", annotations);
-
-  float x_min(std::numeric_limits<float>::max()), y_min(std::numeric_limits<float>::max());
-  for (int i = 0; i < annotations->GetNumberOfItems(); ++i) {
-    auto annotation = vtkPVXMLElement::SafeDownCast(annotations->GetItemAsObject(i));
-    if (!annotation)
-      continue;
-    if (std::string(annotation->GetAttribute("key")) == "Node.x") {
-      x_min = std::min(x_min, (float) std::atof(annotation->GetAttribute("value")));
-    }
-    if (std::string(annotation->GetAttribute("key")) == "Node.y") {
-      y_min = std::min(y_min, (float) std::atof(annotation->GetAttribute("value")));
-    }
-  }
-
-  for (int i = 0; i < annotations->GetNumberOfItems(); ++i) {
-    auto annotation = vtkPVXMLElement::SafeDownCast(annotations->GetItemAsObject(i));
-    if (!annotation)
-      continue;
-    if (std::string(annotation->GetAttribute("key")) == "Node.x") {
-      float node_x = x - x_min + std::atof(annotation->GetAttribute("value")) + SourceGraphicsItem::size_.width() / 2.;
-      annotation->SetAttribute("value", std::to_string(node_x).c_str());
+  // rebase node positions to the paste position
+  auto rebase = [](const std::vector<vtkPVXMLElement *> &annotations, float offset) {
+    std::vector<float> values(annotations.size());
+    float min_value = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < annotations.size(); ++i) {
+      values[i] = std::atof(annotations[i]->GetAttributeOrEmpty("value"));
+      min_value = std::min(min_value, values[i]);
     }
-    if (std::string(annotation->GetAttribute("key")) == "Node.y") {
-      float node_y = y - y_min + std::atof(annotation->GetAttribute("value")) + SourceGraphicsItem::size_.height() / 2.;
-      annotation->SetAttribute("value", std::to_string(node_y).c_str());
+    for (size_t i = 0; i < annotations.size(); ++i) {
+      annotations[i]->SetAttribute("value", std::to_string(offset - min_value + values[i]).c_str());
     }
-  }
+  };
+  rebase(index.node_x, x + SourceGraphicsItem::size_.width() / 2.);
+  rebase(index.node_y, y + SourceGraphicsItem::size_.height() / 2.);
 
-  std::unordered_set<std::string> source_names;
-  auto sources = utilpq::get_sources();
-  for (auto source : sources) {
+  SourceNameIndex source_names;
+  for (auto source : pipeline_sources) {
     source_names.insert(source->getSMName().toStdString());
   }
 
-  auto proxy_collections = vtkSmartPointer<vtkCollection>::New();
-  parser->GetRootElement()->GetElementsByName("ProxyCollection", proxy_collections);
-  for (int i = 0; i < proxy_collections->GetNumberOfItems(); ++i) {
-    auto collection = vtkPVXMLElement::SafeDownCast(proxy_collections->GetItemAsObject(i));
-    if (!collection)
+  for (vtkPVXMLElement *child : index.source_items) {
+    const char *name = child->GetAttribute("name");
+    if (!name || name[0] == '\0')
       continue;
-    if (collection->GetAttributeOrEmpty("name") != std::string("sources"))
-      continue;
-    for (unsigned int j = 0; j < collection->GetNumberOfNestedElements(); ++j) {
-      vtkPVXMLElement *child = collection->GetNestedElement(j);
-      const char *name = child->GetAttribute("name");
-      if (!name)
-        continue;
-      std::string new_name(name);
-      if (new_name.length() <= 0)
-        continue;
-      while (source_names.count(new_name) > 0) {
-        int k = new_name.length();
-        while (k > 0 && std::isdigit(new_name[k - 1])) {
-          --k;
-        }
-        int number = std::atoi(new_name.substr(k, std::string::npos).c_str());
-        new_name = new_name.substr(0, k) + std::to_string(number + 1);
-      }
-      source_names.insert(new_name);
-      child->SetAttribute("name", new_name.c_str());
-    }
+    std::string new_name = source_names.unique(name);
+    child->SetAttribute("name", new_name.c_str());
   }
 
   clearSelection();
@@ -1050,7 +1417,7 @@ void NetworkEditor::paste(float x, float y, bool keep_connections) {
   if (active_view) {
     active_view_proxy = active_view->getViewProxy();
   }
-  auto views = utilpq::get_views();
+  const auto &views = utilpq::get_views();
 
   vtkNew<vtkPasteStateLoader> loader;
   loader->accept_active_view = (pasteMode_ == PASTEMODE_ACTIVE_VIEW);
@@ -1066,7 +1433,7 @@ void NetworkEditor::paste(float x, float y, bool keep_connections) {
   locator->SetFindExistingSources(false);
   locator->SetProxyMap(proxy_map);
   loader->SetProxyLocator(locator);
-  server->proxyManager()->LoadXMLState(parser->GetRootElement(), loader, false);
+  server->proxyManager()->LoadXMLState(paraview_element, loader, false);
   utilpq::collect_dummy_source();
   vtkLog(5,   "done pasting");
 
@@ -1185,8 +1552,11 @@ void NetworkEditor::deleteSelected() {
   }
   if (!delete_connections.empty()) {
     BEGIN_UNDO_SET("Delete Selected Connections");
-    for (auto connection : delete_connections) {
-      removeConnection(connection);
+    {
+      utilpq::ConnectionTransaction transaction;
+      for (auto connection : delete_connections) {
+        removeConnection(connection);
+      }
     }
     END_UNDO_SET();
   }
@@ -1378,6 +1748,7 @@ void NetworkEditor::quickLaunch() {
             for (pqOutputPort* port : selectedOutputPorts) {
               input->RemoveAllUncheckedProxies();
               input->AddUncheckedInputConnection(port->getSourceProxy(), port->getPortNumber());
+              perf_counters::increment(perf_counters::DOMAIN_CHECKS);
               if (input->IsInDomains() > 0) {
                 ports.append(port);
                 if (!input->GetMultipleInput()) {
@@ -1439,7 +1810,58 @@ void NetworkEditor::updateSourcePositions() {
   }
 }
 
+void NetworkEditor::updateSourcePosition(vtkSMProxy *proxy) {
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  auto it = sourceGraphicsItems_.find(smModel->findItem<pqPipelineSource *>(proxy));
+  if (it != sourceGraphicsItems_.end()) {
+    it->second->loadPosition();
+  }
+  scheduleLayoutSave();
+}
+
+void NetworkEditor::scheduleLayoutSave() {
+  if (layoutSavePending_)
+    return;
+  layoutSavePending_ = true;
+  QTimer::singleShot(0, this, [this]() {
+    layoutSavePending_ = false;
+    // the layout of a state that is being loaded is read once stateLoaded is emitted
+    if (pqApplicationCore::instance()->isLoadingState()) {
+      return;
+    }
+    auto settings = this->getGlobalOptions();
+    if (!settings)
+      return;
+    BEGIN_UNDO_EXCLUDE();
+    node_layout::save(settings);
+    END_UNDO_EXCLUDE();
+  });
+}
+
+void NetworkEditor::storePosition(SourceGraphicsItem *item, vtkNodeGeometryUndoElement *undo_element) {
+  QPointF old_pos = item->storedPosition();
+  if (item->storePosition()) {
+    QPointF delta = item->storedPosition() - old_pos;
+    undo_element->AddNode(item->getSource()->getProxy()->GetGlobalID(), delta.x(), delta.y());
+  }
+}
+
+void NetworkEditor::addUndoElement(const QString &label, vtkNodeGeometryUndoElement *undo_element) {
+  if (undo_element->IsEmpty())
+    return;
+  pqServer *server = pqActiveObjects::instance().activeServer();
+  if (!server)
+    return;
+  undo_element->SetSession(server->session());
+  undo_element->SetNetworkEditor(this);
+  BEGIN_UNDO_SET(label);
+  ADD_UNDO_ELEM(undo_element);
+  END_UNDO_SET();
+  scheduleLayoutSave();
+}
+
 void NetworkEditor::computeGraphLayout() {
+  vtkLogScopeFunction(8);
 #ifdef ENABLE_GRAPHVIZ
   std::vector<size_t> nodes;
   std::vector<std::pair<size_t, size_t>> edges;
@@ -1466,16 +1888,399 @@ void NetworkEditor::computeGraphLayout() {
 
   std::map<size_t, std::pair<float, float>> layout = compute_graph_layout(nodes, edges);
 
-  BEGIN_UNDO_SET("Graph Layout");
+  auto undo_element = vtkSmartPointer<vtkNodeGeometryUndoElement>::New();
   for (const auto &kv : id_map) {
     if (layout.count(kv.first) < 1)
       continue;
     QPointF pos(layout[kv.first].first, layout[kv.first].second);
     kv.second->setPos(snapToGrid(pos));
-    kv.second->storePosition();
+    this->storePosition(kv.second, undo_element);
+  }
+  this->addUndoElement("Graph Layout", undo_element);
+#endif
+}
+
+void NetworkEditor::buildAnalysisGraph(pipeline_analysis::Graph &graph, std::vector<pqPipelineSource *> &nodes) const {
+  std::unordered_map<pqPipelineSource *, size_t> index;
+  nodes.clear();
+  for (const auto &kv : sourceGraphicsItems_) {
+    if (qgraphicsitem_cast<StickyNoteGraphicsItem *>(kv.second))
+      continue;
+    index[kv.first] = nodes.size();
+    nodes.push_back(kv.first);
+  }
+  graph.num_nodes = nodes.size();
+  graph.edges.clear();
+  for (const auto &kv : connectionGraphicsItems_) {
+    if (kv.second.empty())
+      continue;
+    auto source = index.find(std::get<0>(kv.first));
+    auto dest = index.find(std::get<1>(kv.first));
+    if (source == index.end() || dest == index.end())
+      continue;
+    graph.edges.emplace_back(source->second, dest->second);
+  }
+}
+
+std::vector<pipeline_analysis::CriticalPath> NetworkEditor::computeCriticalPaths(
+    std::vector<pqPipelineSource *> &nodes) const {
+  vtkLogScopeFunction(8);
+  pipeline_analysis::Graph graph;
+  this->buildAnalysisGraph(graph, nodes);
+
+  auto timer = ExecutionTimer::instance();
+  const auto visible_ports = utilpq::visible_output_ports();
+  std::vector<double> weights(nodes.size(), 0.);
+  std::vector<size_t> sinks;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    weights[i] = timer->lastTime(nodes[i]);
+    for (pqOutputPort *port : nodes[i]->getOutputPorts()) {
+      if (visible_ports.count(port)) {
+        sinks.push_back(i);
+        break;
+      }
+    }
+  }
+  return pipeline_analysis::critical_paths(graph, weights, sinks);
+}
+
+void NetworkEditor::highlightCriticalPath() {
+  std::vector<pqPipelineSource *> nodes;
+  auto paths = this->computeCriticalPaths(nodes);
+  this->clearHighlights();
+  if (paths.empty()) {
+    vtkLog(WARNING, "No source is visible in any view, there is no critical path to show.");
+    return;
+  }
+  if (paths.front().cost <= 0.) {
+    vtkLog(WARNING, "No execution times were recorded. Select an execution time overlay and apply the pipeline first.");
+    return;
+  }
+
+  std::vector<pqPipelineSource *> sources;
+  std::vector<std::pair<pqPipelineSource *, pqPipelineSource *>> connections;
+  for (size_t node : paths.front().nodes) {
+    if (!sources.empty())
+      connections.emplace_back(sources.back(), nodes[node]);
+    sources.push_back(nodes[node]);
+  }
+  this->highlight(sources, connections, QColor("#00bcd4"));
+}
+
+void NetworkEditor::exportCriticalPaths(QString path) {
+  if (path.isEmpty()) {
+    pqFileDialog file_dialog(nullptr, pqCoreUtilities::mainWidget(), "Export Critical Paths", QString(), "JSON (*.json)");
+    file_dialog.setObjectName("NetworkEditorCriticalPathDialog");
+    file_dialog.setFileMode(pqFileDialog::AnyFile);
+    if (file_dialog.exec() != QDialog::Accepted)
+      return;
+    path = file_dialog.getSelectedFiles()[0];
+  }
+
+  std::vector<pqPipelineSource *> nodes;
+  auto timer = ExecutionTimer::instance();
+  QJsonArray json_paths;
+  for (const auto &critical_path : this->computeCriticalPaths(nodes)) {
+    QJsonArray json_nodes;
+    for (size_t node : critical_path.nodes) {
+      QJsonObject json_node;
+      json_node["name"] = nodes[node]->getSMName();
+      json_node["type"] = QString(nodes[node]->getProxy()->GetXMLName());
+      json_node["time"] = timer->lastTime(nodes[node]);
+      json_nodes.append(json_node);
+    }
+    QJsonObject json_path;
+    json_path["sink"] = nodes[critical_path.sink]->getSMName();
+    json_path["time"] = critical_path.cost;
+    json_path["nodes"] = json_nodes;
+    json_paths.append(json_path);
+  }
+  QJsonObject root;
+  root["version"] = 1;
+  root["timing"] = timer->isEnabled() ? "last execution, seconds" : "not recorded";
+  root["paths"] = json_paths;
+
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    vtkLog(ERROR, "Could not write critical paths to " << path.toStdString());
+    return;
+  }
+  file.write(QJsonDocument(root).toJson());
+}
+
+void NetworkEditor::exportTrace(QString path) {
+  if (path.isEmpty()) {
+    pqFileDialog file_dialog(nullptr, pqCoreUtilities::mainWidget(), "Save Trace", QString(), "Chrome Trace (*.json)");
+    file_dialog.setObjectName("NetworkEditorChromeTraceDialog");
+    file_dialog.setFileMode(pqFileDialog::AnyFile);
+    if (file_dialog.exec() != QDialog::Accepted)
+      return;
+    path = file_dialog.getSelectedFiles()[0];
+  }
+  if (!chrome_trace::write(path)) {
+    vtkLog(ERROR, "Could not write trace to " << path.toStdString());
+  }
+}
+
+void NetworkEditor::updateSelectedUpstream() {
+  vtkLogScopeFunction(8);
+  pipeline_analysis::Graph graph;
+  std::vector<pqPipelineSource *> nodes;
+  this->buildAnalysisGraph(graph, nodes);
+
+  std::vector<bool> selected(nodes.size(), false);
+  std::vector<pqPipelineSource *> targets;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    auto it = sourceGraphicsItems_.find(nodes[i]);
+    if (it != sourceGraphicsItems_.end() && it->second->isSelected()) {
+      selected[i] = true;
+      targets.push_back(nodes[i]);
+    }
+  }
+  if (targets.empty())
+    return;
+  std::vector<bool> upstream = pipeline_analysis::upstream_nodes(graph, selected);
+
+  BEGIN_UNDO_SET("Apply Upstream");
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (!upstream[i] || nodes[i]->modifiedState() == pqProxy::UNMODIFIED)
+      continue;
+    const bool uninitialized = nodes[i]->modifiedState() == pqProxy::UNINITIALIZED;
+    utilpq::accept_unchecked_values(nodes[i]);
+    nodes[i]->setModifiedState(pqProxy::UNMODIFIED);
+    // new sources are shown, as by Apply
+    if (uninitialized && selected[i])
+      utilpq::set_source_visiblity(nodes[i], true);
   }
   END_UNDO_SET();
+
+  // the demand driven pipeline only executes the targets and their inputs
+  for (pqPipelineSource *source : targets) {
+    source->updatePipeline();
+  }
+  for (pqView *view : utilpq::get_views()) {
+    view->render();
+  }
+}
+
+std::vector<pqPipelineSource *> NetworkEditor::findDeadBranches() const {
+  vtkLogScopeFunction(8);
+  pipeline_analysis::Graph graph;
+  std::vector<pqPipelineSource *> nodes;
+  this->buildAnalysisGraph(graph, nodes);
+
+  const auto visible_ports = utilpq::visible_output_ports();
+  std::vector<bool> live(nodes.size(), false);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (pqOutputPort *port : nodes[i]->getOutputPorts()) {
+      if (visible_ports.count(port)) {
+        live[i] = true;
+        break;
+      }
+    }
+  }
+  std::vector<bool> dead = pipeline_analysis::dead_nodes(graph, live);
+
+  std::vector<pqPipelineSource *> dead_sources;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (dead[i])
+      dead_sources.push_back(nodes[i]);
+  }
+  return dead_sources;
+}
+
+void NetworkEditor::highlightDeadBranches() {
+  std::vector<pqPipelineSource *> dead_sources = this->findDeadBranches();
+  std::unordered_set<pqPipelineSource *> dead(dead_sources.begin(), dead_sources.end());
+  // connections into a dead source only carry data that is never shown
+  std::vector<std::pair<pqPipelineSource *, pqPipelineSource *>> connections;
+  for (const auto &kv : connectionGraphicsItems_) {
+    if (!kv.second.empty() && dead.count(std::get<1>(kv.first)))
+      connections.emplace_back(std::get<0>(kv.first), std::get<1>(kv.first));
+  }
+  this->clearHighlights();
+  this->highlight(dead_sources, connections, QColor("#ff5252"));
+}
+
+void NetworkEditor::selectDeadBranches() {
+  std::vector<pqPipelineSource *> dead_sources = this->findDeadBranches();
+  this->clearSelection();
+  for (pqPipelineSource *source : dead_sources) {
+    auto it = sourceGraphicsItems_.find(source);
+    if (it != sourceGraphicsItems_.end())
+      it->second->setSelected(true);
+  }
+}
+
+void NetworkEditor::deleteDeadBranches() {
+  std::vector<pqPipelineSource *> dead_sources = this->findDeadBranches();
+  if (dead_sources.empty())
+    return;
+#if (PARAVIEW_VERSION_MAJOR > 5) || (PARAVIEW_VERSION_MAJOR == 5 && PARAVIEW_VERSION_MINOR >= 9)
+  QSet<pqProxy *> delete_sources;
+#else
+  QSet<pqPipelineSource *> delete_sources;
 #endif
+  // every consumer of a dead source is dead as well, so the whole set can be deleted as a single undo set
+  for (pqPipelineSource *source : dead_sources) {
+    delete_sources.insert(source);
+  }
+  this->clearSelection();
+  deleteReaction_->deleteSources(delete_sources);
+  utilpq::collect_dummy_source();
+}
+
+std::vector<std::vector<pqPipelineSource *>> NetworkEditor::findDuplicates() const {
+  vtkLogScopeFunction(8);
+  pipeline_analysis::Graph graph;
+  std::vector<pqPipelineSource *> nodes;
+  this->buildAnalysisGraph(graph, nodes);
+  std::unordered_map<vtkSMProxy *, size_t> index;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    index[nodes[i]->getProxy()] = i;
+  }
+
+  auto node_signature = [&nodes, &index](size_t node, const std::vector<size_t> &groups) {
+    vtkSMProxy *proxy = nodes[node]->getProxy();
+    std::string signature;
+    append_proxy_signature(signature, proxy, 0);
+    // inputs by the group of the producer and the output port, in order
+    auto iter = vtkSmartPointer<vtkSMPropertyIterator>::Take(proxy->NewPropertyIterator());
+    for (iter->Begin(); !iter->IsAtEnd(); iter->Next()) {
+      auto ip = vtkSMInputProperty::SafeDownCast(iter->GetProperty());
+      if (!ip)
+        continue;
+      signature += iter->GetKey();
+      signature += '<';
+      for (unsigned int i = 0; i < ip->GetNumberOfProxies(); ++i) {
+        auto it = index.find(ip->GetProxy(i));
+        if (it != index.end()) {
+          signature += std::to_string(groups[it->second]);
+        } else {
+          // the dummy source of unconnected inputs
+          signature += 'x' + std::to_string(ip->GetProxy(i) ? ip->GetProxy(i)->GetGlobalID() : 0);
+        }
+        signature += ':' + std::to_string(ip->GetOutputPortForConnection(i)) + ',';
+      }
+      signature += ';';
+    }
+    return signature;
+  };
+  std::vector<size_t> groups = pipeline_analysis::equivalent_nodes(graph, node_signature);
+
+  std::unordered_map<size_t, std::vector<pqPipelineSource *>> members;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    members[groups[i]].push_back(nodes[i]);
+  }
+  // keep a visible source, so that merging does not change what is shown, otherwise the oldest
+  const auto visible_ports = utilpq::visible_output_ports();
+  auto visible = [&visible_ports](pqPipelineSource *source) {
+    for (pqOutputPort *port : source->getOutputPorts()) {
+      if (visible_ports.count(port))
+        return true;
+    }
+    return false;
+  };
+  std::vector<std::vector<pqPipelineSource *>> duplicates;
+  for (auto &kv : members) {
+    if (kv.second.size() < 2)
+      continue;
+    std::vector<pqPipelineSource *> &group = kv.second;
+    auto survivor = std::min_element(group.begin(), group.end(), [&visible](pqPipelineSource *a, pqPipelineSource *b) {
+      bool visible_a = visible(a), visible_b = visible(b);
+      if (visible_a != visible_b)
+        return visible_a;
+      return a->getProxy()->GetGlobalID() < b->getProxy()->GetGlobalID();
+    });
+    std::iter_swap(group.begin(), survivor);
+    duplicates.push_back(std::move(group));
+  }
+  return duplicates;
+}
+
+void NetworkEditor::highlightDuplicates() {
+  std::vector<pqPipelineSource *> sources;
+  for (const auto &group : this->findDuplicates()) {
+    sources.insert(sources.end(), group.begin(), group.end());
+  }
+  this->clearHighlights();
+  this->highlight(sources, {}, QColor("#ffb300"));
+}
+
+void NetworkEditor::mergeDuplicates() {
+  auto duplicates = this->findDuplicates();
+  if (duplicates.empty())
+    return;
+#if (PARAVIEW_VERSION_MAJOR > 5) || (PARAVIEW_VERSION_MAJOR == 5 && PARAVIEW_VERSION_MINOR >= 9)
+  QSet<pqProxy *> delete_sources;
+#else
+  QSet<pqPipelineSource *> delete_sources;
+#endif
+  for (const auto &group : duplicates) {
+    for (size_t i = 1; i < group.size(); ++i) {
+      delete_sources.insert(group[i]);
+    }
+  }
+
+  this->clearHighlights();
+  this->clearSelection();
+  BEGIN_UNDO_SET(QString("Merge %1 Duplicates").arg(delete_sources.size()));
+  {
+    utilpq::ConnectionTransaction transaction;
+    for (const auto &group : duplicates) {
+      for (size_t i = 1; i < group.size(); ++i) {
+        for (pqPipelineSource *consumer : group[i]->getAllConsumers()) {
+          // consumers that are duplicates themselves are deleted as well
+          if (delete_sources.contains(consumer))
+            continue;
+          if (auto filter = qobject_cast<pqPipelineFilter *>(consumer))
+            utilpq::replace_input(filter, group[i], group.front());
+        }
+      }
+    }
+  }
+  // nested in the merge, so that a single undo restores the duplicates and their connections
+  deleteReaction_->deleteSources(delete_sources);
+  END_UNDO_SET();
+  utilpq::collect_dummy_source();
+}
+
+void NetworkEditor::highlight(const std::vector<pqPipelineSource *> &sources,
+                              const std::vector<std::pair<pqPipelineSource *, pqPipelineSource *>> &connections,
+                              const QColor &color) {
+  for (pqPipelineSource *source : sources) {
+    highlights_[source] = color;
+  }
+  for (const auto &connection : connections) {
+    auto it = connectionGraphicsItems_.find(std::make_tuple(connection.first, connection.second));
+    if (it == connectionGraphicsItems_.end())
+      continue;
+    for (const auto &kv : it->second) {
+      kv.second->setBorderColor(color);
+      kv.second->update();
+    }
+    highlightedConnections_.push_back(connection);
+  }
+  this->update();
+}
+
+void NetworkEditor::clearHighlights() {
+  for (const auto &connection : highlightedConnections_) {
+    auto it = connectionGraphicsItems_.find(std::make_tuple(connection.first, connection.second));
+    if (it == connectionGraphicsItems_.end())
+      continue;
+    for (const auto &kv : it->second) {
+      kv.second->resetBorderColors();
+    }
+  }
+  highlightedConnections_.clear();
+  highlights_.clear();
+  this->update();
+}
+
+QColor NetworkEditor::highlightColor(pqPipelineSource *source) const {
+  auto it = highlights_.find(source);
+  return it != highlights_.end() ? it->second : QColor();
 }
 
 }
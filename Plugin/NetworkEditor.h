@@ -1,10 +1,13 @@
 #ifndef PARAVIEWNETWORKEDITOR_PLUGIN_NETWORKEDITOR_H_
 #define PARAVIEWNETWORKEDITOR_PLUGIN_NETWORKEDITOR_H_
 
+#include <QBrush>
 #include <QGraphicsScene>
 #include <QGraphicsItem>
 #include <map>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 class pqPipelineSource;
 class QGraphicsSceneContextMenuEvent;
@@ -18,6 +21,12 @@ class ConnectionGraphicsItem;
 class ConnectionDragHelper;
 class OutputPortGraphicsItem;
 class InputPortGraphicsItem;
+class vtkNodeGeometryUndoElement;
+
+namespace pipeline_analysis {
+struct Graph;
+struct CriticalPath;
+}
 
 class NetworkEditor : public QGraphicsScene {
  Q_OBJECT
@@ -35,6 +44,9 @@ class NetworkEditor : public QGraphicsScene {
   void hideSelected();
   void showSelectedScalarBars();
   void hideSelectedScalarBars();
+  // Applies the pending property changes of the selected sources and everything upstream of them and updates
+  // only these sources. Other modified sources keep their pending changes and do not execute.
+  void updateSelectedUpstream();
 
   void selectAll();
   void deleteSelected();
@@ -42,17 +54,49 @@ class NetworkEditor : public QGraphicsScene {
   void paste(float x, float y, bool keep_connections);
   void paste(bool keep_connections);
   void setPasteMode(int);
+  void setOverlayMode(int);
+  // Fill color of the node in the current overlay, invalid if no overlay is shown or it has no value for the source.
+  QColor overlayColor(pqPipelineSource *source) const;
+  // Title, label of the largest value and color scale of the current overlay, false if no overlay is shown. The
+  // legend is drawn by NetworkEditorView, so screenshots and exports of the scene never contain it.
+  bool overlayLegend(QString &title, QString &max_label, QGradientStops &stops) const;
   void quickLaunch();
 
   void computeGraphLayout();
 
+  // Pipeline analyses. Their results stay highlighted until clearHighlights is called.
+  void highlightCriticalPath();
+  // Writes the critical path of each visible source as JSON. Asks for a file if the path is empty.
+  void exportCriticalPaths(QString path);
+  // Dead branches are sources that are not visible in any view and do not feed a visible source.
+  void highlightDeadBranches();
+  void selectDeadBranches();
+  void deleteDeadBranches();
+  // Duplicates are sources of the same type with equal property values that read the same inputs.
+  void highlightDuplicates();
+  // Rewires the consumers of each duplicate to one survivor and deletes the other duplicates.
+  void mergeDuplicates();
+  void clearHighlights();
+  // Border color of the node if it is highlighted by an analysis, invalid otherwise.
+  QColor highlightColor(pqPipelineSource *source) const;
+  // Writes the scopes recorded since the trace was started as Chrome trace JSON. Asks for a file if the path is empty.
+  void exportTrace(QString path);
+
   void updateSourcePositions();
+  void updateSourcePosition(vtkSMProxy *proxy);
+  // Pushes the recorded node geometry changes as a single undo set. Does nothing if the element is empty.
+  void addUndoElement(const QString &label, vtkNodeGeometryUndoElement *undo_element);
   void updateSceneSize();
   bool empty() const;
   QRectF getSourcesBoundingRect() const;
 
   void setBackgroundTransparent(bool);
 
+  // The performance HUD shows the time and counters of the last frame in the top left corner of the views. It is
+  // drawn by NetworkEditorView, so screenshots and exports of the scene never contain it.
+  void setPerformanceHud(bool enabled);
+  bool performanceHud() const { return performanceHud_; }
+
   // Called from ProcessorPortGraphicsItems mouse events.
   void initiateConnection(OutputPortGraphicsItem *item);
   void releaseConnection(InputPortGraphicsItem *item);
@@ -61,6 +105,9 @@ class NetworkEditor : public QGraphicsScene {
 
   void storeTransform(const QTransform&, int, int);
 
+  // Shows the current tooltip again once the next batch of data information arrives.
+  void refreshToolTipOnDataInformation();
+
  protected:
   virtual void contextMenuEvent(QGraphicsSceneContextMenuEvent *e) override;
   void onSelectionChanged();
@@ -79,7 +126,6 @@ class NetworkEditor : public QGraphicsScene {
   T *getGraphicsItemAt(const QPointF pos) const;
 
   void drawBackground(QPainter *painter, const QRectF &rect) override;
-  void drawForeground(QPainter *painter, const QRectF &rect) override;
 
   bool backgroundTransparent_ {false};
 
@@ -96,11 +142,43 @@ class NetworkEditor : public QGraphicsScene {
   };
 
   PasteMode pasteMode_ = PASTEMODE_NO_VIEWS;
+
+  enum OverlayMode {
+    OVERLAY_NONE,
+    OVERLAY_LAST_EXECUTION_TIME,
+    OVERLAY_TOTAL_EXECUTION_TIME,
+    OVERLAY_MEMORY,
+    OVERLAY_BRANCH_MEMORY,
+  };
+
+  OverlayMode overlayMode_ = OVERLAY_NONE;
+
+  bool performanceHud_ = false;
+
+  // Sources without sticky notes, and the connections between them, for the pipeline analyses.
+  void buildAnalysisGraph(pipeline_analysis::Graph &graph, std::vector<pqPipelineSource *> &nodes) const;
+  std::vector<pipeline_analysis::CriticalPath> computeCriticalPaths(std::vector<pqPipelineSource *> &nodes) const;
+  std::vector<pqPipelineSource *> findDeadBranches() const;
+  // Groups of identical sources, the survivor of a merge first.
+  std::vector<std::vector<pqPipelineSource *>> findDuplicates() const;
+  void highlight(const std::vector<pqPipelineSource *> &sources,
+                 const std::vector<std::pair<pqPipelineSource *, pqPipelineSource *>> &connections,
+                 const QColor &color);
+  std::map<pqPipelineSource *, QColor> highlights_;
+  std::vector<std::pair<pqPipelineSource *, pqPipelineSource *>> highlightedConnections_;
   bool updateSelection_ = false;
   static const int gridSpacing_;
   QPointF snapToGrid(const QPointF &pos);
+  void storePosition(SourceGraphicsItem *item, vtkNodeGeometryUndoElement *undo_element);
+  // Writes the node layout table to the settings proxy once control returns to the event loop.
+  void scheduleLayoutSave();
+  bool layoutSavePending_ = false;
   bool mouseDown_ = false;
 
+  bool refreshToolTip_ = false;
+  QPointF lastHelpScenePos_;
+  QPoint lastHelpScreenPos_;
+
   QPointF lastMousePos_ = QPointF(0., 0.);
   QPointF lastMouseMovePos_ = QPointF(0., 0.);
   bool addSourceAtMousePos_ = false;
@@ -1,13 +1,21 @@
 #include "NetworkEditorView.h"
 #include "NetworkEditor.h"
+#include "InteractionRecorder.h"
 #include "utilqt.h"
 
+#include <QElapsedTimer>
+#include <QFontMetrics>
+#include <QLinearGradient>
+#include <QPaintEvent>
+#include <QPainter>
 #include <QWheelEvent>
 #include <QtMath>
 #include <QScrollBar>
 
 #include <vtkLogger.h>
 
+#include <vector>
+
 namespace ParaViewNetworkEditor {
 
 NetworkEditorView::NetworkEditorView(NetworkEditor *networkEditor, QWidget *parent)
@@ -25,6 +33,7 @@ NetworkEditorView::NetworkEditorView(NetworkEditor *networkEditor, QWidget *pare
 
   setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
 
+  recorder_ = new InteractionRecorder(this);
 }
 
 NetworkEditorView::~NetworkEditorView() {
@@ -77,6 +86,17 @@ void NetworkEditorView::wheelEvent(QWheelEvent *e) {
   e->accept();
 }
 
+void NetworkEditorView::scrollContentsBy(int dx, int dy) {
+  QGraphicsView::scrollContentsBy(dx, dy);
+  // the viewport pixels were scrolled along with the scene, the legend and the HUD stay where they are
+  for (const QRect &rect : {legendRect_, hudRect_}) {
+    if (!rect.isEmpty()) {
+      viewport()->update(rect);
+      viewport()->update(rect.translated(dx, dy));
+    }
+  }
+}
+
 void NetworkEditorView::zoom(double dz) {
   if ((dz > 1.0 && transform().m11() > 8.0) || (dz < 1.0 && transform().m11() < 0.125)) return;
 
@@ -92,6 +112,123 @@ void NetworkEditorView::mouseDoubleClickEvent(QMouseEvent *e) {
   }
 }
 
+void NetworkEditorView::paintEvent(QPaintEvent *event) {
+  vtkLogScopeFunction(8);
+  if (!editor_->performanceHud()) {
+    hudRect_ = QRect();
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+  const perf_counters::Snapshot before = perf_counters::snapshot();
+  QElapsedTimer timer;
+  timer.start();
+  QGraphicsView::paintEvent(event);
+  const double milliseconds = timer.nsecsElapsed() * 1e-6;
+
+  // The HUD shows the previous frame, so it is repainted on its own after each frame. These repaints are not
+  // recorded themselves, which would show the cost of the HUD instead.
+  if (hudRect_.isEmpty() || !hudRect_.contains(event->region().boundingRect())) {
+    frameTime_ = milliseconds;
+    frameCounts_ = perf_counters::difference(perf_counters::snapshot(), before);
+    viewport()->update(hudRect_);
+  }
+}
+
+void NetworkEditorView::drawForeground(QPainter *painter, const QRectF &rect) {
+  QGraphicsView::drawForeground(painter, rect);
+  this->drawOverlayLegend(painter);
+  if (editor_->performanceHud()) {
+    this->drawPerformanceHud(painter);
+  }
+}
+
+void NetworkEditorView::drawOverlayLegend(QPainter *painter) {
+  QString title;
+  QString max_label;
+  QGradientStops stops;
+  if (!editor_->overlayLegend(title, max_label, stops)) {
+    legendRect_ = QRect();
+    return;
+  }
+
+  // the legend is drawn in device coordinates, in the bottom left corner
+  static constexpr int margin = 10;
+  static constexpr int barWidth = 150;
+  static constexpr int barHeight = 10;
+  painter->save();
+  painter->setWorldMatrixEnabled(false);
+  QFont font("Noto Sans");
+  font.setPixelSize(11);
+  painter->setFont(font);
+  const int lineHeight = painter->fontMetrics().height();
+  const QRect device = painter->viewport();
+  QRect bar(device.left() + margin, device.bottom() - margin - lineHeight - barHeight, barWidth, barHeight);
+  QRect background = bar.adjusted(-5, -lineHeight - 5, 5, lineHeight + 5);
+  legendRect_ = background.adjusted(-1, -1, 1, 1);
+
+  painter->setRenderHint(QPainter::Antialiasing, true);
+  painter->setPen(Qt::NoPen);
+  painter->setBrush(QColor(0x28, 0x28, 0x28, 200));
+  painter->drawRoundedRect(background, 4, 4);
+
+  QLinearGradient gradient(bar.topLeft(), bar.topRight());
+  gradient.setStops(stops);
+  painter->setBrush(gradient);
+  painter->drawRect(bar);
+
+  painter->setPen(Qt::white);
+  painter->drawText(QRect(bar.left(), bar.top() - lineHeight - 2, barWidth, lineHeight), Qt::AlignLeft, title);
+  painter->drawText(QRect(bar.left(), bar.bottom() + 2, barWidth, lineHeight), Qt::AlignLeft, "0");
+  painter->drawText(QRect(bar.left(), bar.bottom() + 2, barWidth, lineHeight), Qt::AlignRight, max_label);
+  painter->restore();
+}
+
+
+void NetworkEditorView::drawPerformanceHud(QPainter *painter) {
+  // drawn in device coordinates, in the top left corner
+  static constexpr int margin = 10;
+  static constexpr int padding = 5;
+  painter->save();
+  painter->setWorldMatrixEnabled(false);
+  QFont font("Noto Sans");
+  font.setPixelSize(11);
+  painter->setFont(font);
+  const QFontMetrics metrics = painter->fontMetrics();
+
+  const perf_counters::Snapshot totals = perf_counters::snapshot();
+  std::vector<std::pair<QString, QString>> rows;
+  rows.emplace_back("Frame time", QString("%1 ms").arg(frameTime_, 0, 'f', 2));
+  for (int i = 0; i < perf_counters::NUM_COUNTERS; ++i) {
+    rows.emplace_back(perf_counters::label(static_cast<perf_counters::Counter>(i)),
+                      QString("%1 (%2)").arg(frameCounts_[i]).arg(totals[i]));
+  }
+  int label_width = 0;
+  int value_width = metrics.size(Qt::TextSingleLine, "0000 (00000000)").width();
+  for (const auto &row : rows) {
+    label_width = std::max(label_width, metrics.size(Qt::TextSingleLine, row.first).width());
+    value_width = std::max(value_width, metrics.size(Qt::TextSingleLine, row.second).width());
+  }
+  const int line_height = metrics.height();
+  const QRect device = painter->viewport();
+  QRect background(device.left() + margin, device.top() + margin,
+                   label_width + value_width + 4 * padding, static_cast<int>(rows.size()) * line_height + 2 * padding);
+  hudRect_ = background.adjusted(-1, -1, 1, 1);
+
+  painter->setRenderHint(QPainter::Antialiasing, true);
+  painter->setPen(Qt::NoPen);
+  painter->setBrush(QColor(0x28, 0x28, 0x28, 200));
+  painter->drawRoundedRect(background, 4, 4);
+  painter->setPen(Qt::white);
+  int y = background.top() + padding;
+  for (const auto &row : rows) {
+    painter->drawText(QRect(background.left() + padding, y, label_width, line_height), Qt::AlignLeft, row.first);
+    painter->drawText(QRect(background.right() - padding - value_width, y, value_width, line_height),
+                      Qt::AlignRight, row.second);
+    y += line_height;
+  }
+  painter->restore();
+}
+
 void NetworkEditorView::fitNetwork() {
   const auto scale = utilqt::emToPx(this, 1.0) / static_cast<double>(utilqt::refEm());
   setTransform(QTransform::fromScale(scale, scale), false);
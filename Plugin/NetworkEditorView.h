@@ -1,11 +1,14 @@
 #ifndef PARAVIEWNETWORKEDITOR_PLUGIN_NETWORKEDITORVIEW_H_
 #define PARAVIEWNETWORKEDITOR_PLUGIN_NETWORKEDITORVIEW_H_
 
+#include "perf_counters.h"
+
 #include <QGraphicsView>
 
 namespace ParaViewNetworkEditor {
 
 class NetworkEditor;
+class InteractionRecorder;
 
 class NetworkEditorView : public QGraphicsView {
  public:
@@ -14,6 +17,9 @@ class NetworkEditorView : public QGraphicsView {
 
   void fitNetwork();
 
+  // Records the input events of the view, for replaying them as a benchmark.
+  InteractionRecorder *recorder() const { return recorder_; }
+
  protected:
   bool viewportEvent(QEvent *event) override;
   void wheelEvent(QWheelEvent *e) override;
@@ -21,9 +27,23 @@ class NetworkEditorView : public QGraphicsView {
   virtual void keyReleaseEvent(QKeyEvent *keyEvent) override;
   virtual void focusOutEvent(QFocusEvent *) override;
   virtual void mouseDoubleClickEvent(QMouseEvent *e) override;
+  void paintEvent(QPaintEvent *event) override;
+  void drawForeground(QPainter *painter, const QRectF &rect) override;
+  void scrollContentsBy(int dx, int dy) override;
 
  private:
   NetworkEditor *editor_;
+  InteractionRecorder *recorder_;
+
+  // time and counters of the last frame, and the device rect of the performance HUD that shows them
+  double frameTime_ = 0.;
+  perf_counters::Snapshot frameCounts_ {};
+  QRect hudRect_;
+  void drawPerformanceHud(QPainter *painter);
+
+  // legend of the overlay of the editor, in the bottom left corner
+  QRect legendRect_;
+  void drawOverlayLegend(QPainter *painter);
   void zoom(double dz);
 };
 
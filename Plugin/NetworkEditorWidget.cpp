@@ -2,7 +2,9 @@
 
 #include "NetworkEditor.h"
 #include "NetworkEditorView.h"
+#include "InteractionRecorder.h"
 #include "utilqt.h"
+#include "pipeline_screenshot.h"
 #include "vtkPVNetworkEditorSettings.h"
 
 #include <pqSettings.h>
@@ -29,12 +31,11 @@
 #include <QProcessEnvironment>
 #include <QToolButton>
 #include <QProxyStyle>
+#include <QRunnable>
+#include <QThreadPool>
 #include <QToolTip>
 #include <QMenuBar>
 #include <QKeyEvent>
-#ifdef QT_HAS_SVG
-# include <QSvgGenerator>
-#endif
 
 #include <iostream>
 
@@ -56,6 +57,30 @@ class MyProxyStyle : public QProxyStyle {
   }
 };
 
+class AutoSaveJob : public QRunnable {
+ public:
+  // autoSaveFinished(path, id) of receiver is invoked on its thread once the job is done, cancelled or not.
+  AutoSaveJob(const QPicture &picture, const QSize &size, const QString &path, qulonglong id,
+              std::shared_ptr<std::atomic<bool>> cancel, QObject *receiver)
+      : picture_(picture), size_(size), path_(path), id_(id), cancel_(std::move(cancel)), receiver_(receiver) {}
+
+  void run() override {
+    if (!pipeline_screenshot::write_png(picture_, size_, path_, cancel_.get()) && !cancel_->load()) {
+      vtkLog(ERROR, "Could not save network screenshot to " << path_.toStdString());
+    }
+    QMetaObject::invokeMethod(receiver_, "autoSaveFinished", Qt::QueuedConnection, Q_ARG(QString, path_),
+                              Q_ARG(qulonglong, id_));
+  }
+
+ private:
+  QPicture picture_;
+  QSize size_;
+  QString path_;
+  qulonglong id_;
+  std::shared_ptr<std::atomic<bool>> cancel_;
+  QObject *receiver_;
+};
+
 }
 
 void NetworkEditorWidget::constructor()
@@ -105,6 +130,17 @@ void NetworkEditorWidget::constructor()
           networkEditor_.get(), &NetworkEditor::setPasteMode);
   hLayout->addWidget(paste_cb);
 
+  auto overlay_cb = new QComboBox();
+  overlay_cb->setToolTip("Color sources by their cost. Execution times are recorded while a time overlay is selected.");
+  overlay_cb->addItem("No overlay");
+  overlay_cb->addItem("Last execution time");
+  overlay_cb->addItem("Total execution time");
+  overlay_cb->addItem("Output memory");
+  overlay_cb->addItem("Downstream memory");
+  connect(overlay_cb, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+          networkEditor_.get(), &NetworkEditor::setOverlayMode);
+  hLayout->addWidget(overlay_cb);
+
   QIcon saveIcon(
       (vtkSMProxyManager::GetVersionMajor() == 5 && vtkSMProxyManager::GetVersionMinor() == 7)
       ? ":/pqWidgets/Icons/pqCaptureScreenshot24.png" : ":/pqWidgets/Icons/pqCaptureScreenshot.svg");
@@ -117,6 +153,31 @@ void NetworkEditorWidget::constructor()
   btnSave->setDefaultAction(saveAction);
   hLayout->addWidget(btnSave);
 
+  auto record = new QAction("Record", this);
+  record->setToolTip("Record interaction with the network editor, to replay it as a benchmark with pvnetworkreplay.");
+  record->setCheckable(true);
+  connect(record, &QAction::toggled, this, [this](bool checked) {
+    InteractionRecorder *recorder = networkEditorView_->recorder();
+    if (checked) {
+      recorder->start();
+      return;
+    }
+    recorder->stop();
+    pqFileDialog file_dialog(nullptr, pqCoreUtilities::mainWidget(), "Save Interaction Trace", QString(),
+                             "Interaction Trace (*.json)");
+    file_dialog.setObjectName("NetworkEditorTraceDialog");
+    file_dialog.setFileMode(pqFileDialog::AnyFile);
+    if (file_dialog.exec() != QDialog::Accepted)
+      return;
+    const QString path = file_dialog.getSelectedFiles()[0];
+    if (!interaction_trace::save(recorder->trace(), path)) {
+      vtkLog(ERROR, "Could not save interaction trace to " << path.toStdString());
+    }
+  });
+  auto btnRecord = new QToolButton(titleBar);
+  btnRecord->setDefaultAction(record);
+  hLayout->addWidget(btnRecord);
+
   hLayout->addStretch();
 
   QString help_text = R"HTML(
@@ -237,11 +298,54 @@ void NetworkEditorWidget::constructor()
       QFileInfo fileInfo(path);
       path = fileInfo.dir().path() + QDir::separator() + fileInfo.baseName()
              + QString::fromStdString(vtkPVNetworkEditorSettings::GetInstance()->GetAutoSavePipelineSuffix());
-      this->savePipelineScreenshot(path);
+      this->autoSavePipelineScreenshot(path);
     }
   });
 }
 
+NetworkEditorWidget::~NetworkEditorWidget() {
+  for (auto &kv : autoSaveJobs_) {
+    kv.second.cancel->store(true);
+  }
+  if (autoSavePool_) {
+    autoSavePool_->waitForDone();
+  }
+}
+
+void NetworkEditorWidget::autoSavePipelineScreenshot(const QString &path) {
+  using namespace ParaViewNetworkEditor;
+  if (QFileInfo(path).suffix().toLower() == "svg") {
+    this->savePipelineScreenshot(path);
+    return;
+  }
+
+  QSize size;
+  QPicture picture = pipeline_screenshot::record(
+      this->networkEditor_.get(), vtkPVNetworkEditorSettings::GetInstance()->GetPipelineScreenshotScale(),
+      vtkPVNetworkEditorSettings::GetInstance()->GetPipelineScreenshotTransparency(), &size);
+
+  auto &job = autoSaveJobs_[path];
+  if (job.cancel) {
+    job.cancel->store(true);
+  }
+  job.id = ++autoSaveJobCount_;
+  job.cancel = std::make_shared<std::atomic<bool>>(false);
+  if (!autoSavePool_) {
+    // a pool of its own, the jobs wait for the tiles rasterized on the global pool
+    autoSavePool_ = std::make_unique<QThreadPool>();
+    autoSavePool_->setMaxThreadCount(1);
+  }
+  autoSavePool_->start(new AutoSaveJob(picture, size, path, job.id, job.cancel, this));
+}
+
+void NetworkEditorWidget::autoSaveFinished(const QString &path, qulonglong id) {
+  // forget the job, unless a newer job for the same path replaced it in the meantime
+  auto it = autoSaveJobs_.find(path);
+  if (it != autoSaveJobs_.end() && it->second.id == id) {
+    autoSaveJobs_.erase(it);
+  }
+}
+
 void NetworkEditorWidget::savePipelineScreenshot(QString path) const {
   if (path.isEmpty()) {
     const QString skey = QString("extensions/networkeditor/NetworkEditor");
@@ -261,42 +365,10 @@ void NetworkEditorWidget::savePipelineScreenshot(QString path) const {
     path = file;
   }
 
-  QFileInfo fileInfo(path);
-  bool write_png = (fileInfo.suffix().toLower() != "svg");
-
-  const auto br = this->networkEditor_->getSourcesBoundingRect().adjusted(-50, -50, 50, 50);
-  QRectF source = br;
-  QRectF target(QPointF(0, 0), br.size() * 2);
-
-  bool transparency = vtkPVNetworkEditorSettings::GetInstance()->GetPipelineScreenshotTransparency();
-
-  if (write_png) {
-    QImage image(target.size().toSize(), QImage::Format_ARGB32);
-    if (transparency) {
-      image.fill(Qt::transparent);
-    }
-    QPainter painter(&image);
-    this->networkEditor_->setBackgroundTransparent(transparency);
-    this->networkEditorView_->scene()->render(&painter, target, source);
-    this->networkEditor_->setBackgroundTransparent(false);
-    image.save(path);
-  } else {
-#ifdef QT_HAS_SVG
-    QSvgGenerator generator;
-    generator.setFileName(path);
-    generator.setSize(target.size().toSize());
-    generator.setViewBox(target);
-    generator.setDescription("");
-    generator.setTitle("");
-    QPainter painter;
-    painter.begin(&generator);
-    this->networkEditor_->setBackgroundTransparent(transparency);
-    this->networkEditorView_->scene()->render(&painter, target, source);
-    this->networkEditor_->setBackgroundTransparent(false);
-    painter.end();
-#else
-    vtkLog(ERROR, "Qt SVG support not available.");
-#endif
+  if (!ParaViewNetworkEditor::pipeline_screenshot::save(
+          this->networkEditor_.get(), path, vtkPVNetworkEditorSettings::GetInstance()->GetPipelineScreenshotScale(),
+          vtkPVNetworkEditorSettings::GetInstance()->GetPipelineScreenshotTransparency())) {
+    vtkLog(ERROR, "Could not save network screenshot to " << path.toStdString());
   }
 }
 
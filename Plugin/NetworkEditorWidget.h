@@ -1,7 +1,12 @@
 #include "NetworkEditor.h"
 #include <QDockWidget>
+#include <QString>
+#include <atomic>
+#include <map>
 #include <memory>
 
+class QThreadPool;
+
 namespace ParaViewNetworkEditor {
 class NetworkEditorView;
 }
@@ -21,6 +26,8 @@ class NetworkEditorWidget : public QDockWidget {
     this->constructor();
   }
 
+  ~NetworkEditorWidget() override;
+
   void swapWithCentralWidget();
  private:
   bool isCentralWidget_ {false};
@@ -29,6 +36,19 @@ class NetworkEditorWidget : public QDockWidget {
   QWidget *networkEditorWidget_ {nullptr};
   QWidget *renderView_ {nullptr};
   void savePipelineScreenshot(QString path) const;
+  // Records the network and rasterizes and encodes it in the background. Cancels an older job for the same path.
+  void autoSavePipelineScreenshot(const QString &path);
+  std::unique_ptr<QThreadPool> autoSavePool_;
+  // Called by the background job once it is done, queued to the GUI thread. A slot invoked by name, because
+  // queued calls of functors need Qt 5.10.
+  Q_INVOKABLE void autoSaveFinished(const QString &path, qulonglong id);
+  struct AutoSaveJobState {
+    qulonglong id {0};
+    std::shared_ptr<std::atomic<bool>> cancel;
+  };
+  // pending jobs by path, removed on the GUI thread when a job is done
+  std::map<QString, AutoSaveJobState> autoSaveJobs_;
+  qulonglong autoSaveJobCount_ {0};
 
   void constructor();
 };
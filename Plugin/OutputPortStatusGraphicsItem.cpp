@@ -1,6 +1,7 @@
 #include "OutputPortStatusGraphicsItem.h"
 #include "SourceGraphicsItem.h"
 #include "utilpq.h"
+#include "perf_counters.h"
 
 #include <vtkSMParaViewPipelineControllerWithRendering.h>
 #include <vtkSMPVRepresentationProxy.h>
@@ -24,6 +25,7 @@ OutputPortStatusGraphicsItem::OutputPortStatusGraphicsItem(QGraphicsRectItem *pa
 }
 
 void OutputPortStatusGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *, QWidget *) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   qreal ledRadius = size_ / 2.0f;
   QColor baseColor = QColor(0, 170, 0).lighter(200);
 
@@ -0,0 +1,223 @@
+#include "PipelineMimeData.h"
+
+#include <vtkLogger.h>
+#include <vtkNew.h>
+#include <vtkPVXMLElement.h>
+#include <vtkPVXMLParser.h>
+
+#include <QDataStream>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+
+namespace {
+
+// header: magic, format version, length of the compressed payload
+const quint32 binary_magic = 0x50564e45;  // "PVNE"
+const quint32 binary_version = 1;
+const int max_depth = 256;
+
+// Element and attribute names as well as most attribute values repeat many times in a state,
+// so all strings are stored once in a table and referenced by index.
+class StringTable {
+ public:
+  quint32 index(const char *str) {
+    auto result = indices_.emplace(str ? str : "", static_cast<quint32>(strings_.size()));
+    if (result.second)
+      strings_.push_back(&result.first->first);
+    return result.first->second;
+  }
+  void write(QDataStream &stream) const {
+    stream << static_cast<quint32>(strings_.size());
+    for (const std::string *str : strings_)
+      stream.writeBytes(str->data(), static_cast<uint>(str->size()));
+  }
+ private:
+  std::unordered_map<std::string, quint32> indices_;
+  std::vector<const std::string *> strings_;
+};
+
+void write_element(QDataStream &stream, StringTable &strings, vtkPVXMLElement *element) {
+  stream << strings.index(element->GetName());
+  unsigned int num_attributes = element->GetNumberOfAttributes();
+  stream << static_cast<quint32>(num_attributes);
+  for (unsigned int i = 0; i < num_attributes; ++i) {
+    stream << strings.index(element->GetAttributeName(i)) << strings.index(element->GetAttributeValue(i));
+  }
+  const char *character_data = element->GetCharacterData();
+  stream << strings.index(character_data);
+  unsigned int num_nested = element->GetNumberOfNestedElements();
+  stream << static_cast<quint32>(num_nested);
+  for (unsigned int i = 0; i < num_nested; ++i) {
+    write_element(stream, strings, element->GetNestedElement(i));
+  }
+}
+
+bool read_element(QDataStream &stream, const std::vector<QByteArray> &strings, vtkPVXMLElement *element, int depth) {
+  if (depth > max_depth)
+    return false;
+  auto lookup = [&strings](quint32 i) -> const QByteArray * {
+    return i < strings.size() ? &strings[i] : nullptr;
+  };
+  quint32 name, num_attributes;
+  stream >> name >> num_attributes;
+  if (stream.status() != QDataStream::Ok || !lookup(name))
+    return false;
+  element->SetName(lookup(name)->constData());
+  for (quint32 i = 0; i < num_attributes; ++i) {
+    quint32 key, value;
+    stream >> key >> value;
+    if (stream.status() != QDataStream::Ok || !lookup(key) || !lookup(value))
+      return false;
+    element->AddAttribute(lookup(key)->constData(), lookup(value)->constData());
+  }
+  quint32 character_data, num_nested;
+  stream >> character_data >> num_nested;
+  if (stream.status() != QDataStream::Ok || !lookup(character_data))
+    return false;
+  if (!lookup(character_data)->isEmpty()) {
+    element->AddCharacterData(lookup(character_data)->constData(), lookup(character_data)->size());
+  }
+  for (quint32 i = 0; i < num_nested; ++i) {
+    vtkNew<vtkPVXMLElement> nested;
+    if (!read_element(stream, strings, nested, depth + 1))
+      return false;
+    element->AddNestedElement(nested);
+  }
+  return true;
+}
+
+}
+
+const QString PipelineMimeData::mimeType = "application/x-paraview-network-editor-state";
+
+PipelineMimeData::PipelineMimeData(vtkPVXMLElement *state)
+    : state_(state) {
+}
+
+PipelineMimeData::~PipelineMimeData() = default;
+
+QStringList PipelineMimeData::formats() const {
+  return {mimeType, "text/plain"};
+}
+
+bool PipelineMimeData::hasFormat(const QString &mimetype) const {
+  return mimetype == mimeType || mimetype == "text/plain";
+}
+
+QVariant PipelineMimeData::retrieveData(const QString &mimetype, QVariant::Type type) const {
+  if (!state_)
+    return QVariant();
+  if (mimetype == mimeType) {
+    if (binary_.isEmpty())
+      binary_ = encode(state_);
+    return binary_;
+  }
+  if (mimetype == "text/plain") {
+    if (text_.isEmpty()) {
+      vtkLogScopeF(8, "PipelineMimeData: encode text");
+      std::stringstream ss;
+      state_->PrintXML(ss, vtkIndent());
+      std::string str = ss.str();
+      text_ = QByteArray(str.c_str(), static_cast<int>(str.length()));
+    }
+    if (type == QVariant::String)
+      return QString::fromUtf8(text_);
+    return text_;
+  }
+  return QMimeData::retrieveData(mimetype, type);
+}
+
+QByteArray PipelineMimeData::encode(vtkPVXMLElement *state) {
+  vtkLogScopeF(8, "PipelineMimeData::encode");
+  StringTable strings;
+  QByteArray tree;
+  {
+    QDataStream stream(&tree, QIODevice::WriteOnly);
+    write_element(stream, strings, state);
+  }
+  QByteArray payload;
+  {
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    strings.write(stream);
+  }
+  payload.append(tree);
+  QByteArray compressed = qCompress(payload);
+
+  QByteArray data;
+  QDataStream stream(&data, QIODevice::WriteOnly);
+  stream << binary_magic << binary_version << static_cast<quint32>(compressed.size());
+  stream.writeRawData(compressed.constData(), compressed.size());
+  return data;
+}
+
+vtkSmartPointer<vtkPVXMLElement> PipelineMimeData::decode(const QByteArray &data) {
+  vtkLogScopeF(8, "PipelineMimeData::decode");
+  QDataStream header(data);
+  quint32 magic, version, length;
+  header >> magic >> version >> length;
+  if (header.status() != QDataStream::Ok || magic != binary_magic || version != binary_version) {
+    vtkLog(WARNING, "Unknown clipboard format.");
+    return nullptr;
+  }
+  const int offset = 3 * sizeof(quint32);
+  if (static_cast<qint64>(length) > data.size() - offset) {
+    vtkLog(ERROR, "Clipboard contents are truncated.");
+    return nullptr;
+  }
+  QByteArray payload = qUncompress(reinterpret_cast<const uchar *>(data.constData() + offset), static_cast<int>(length));
+  if (payload.isEmpty()) {
+    vtkLog(ERROR, "Could not decompress clipboard contents.");
+    return nullptr;
+  }
+
+  QDataStream stream(payload);
+  quint32 num_strings;
+  stream >> num_strings;
+  if (stream.status() != QDataStream::Ok || num_strings > static_cast<quint32>(payload.size())) {
+    vtkLog(ERROR, "Invalid clipboard contents.");
+    return nullptr;
+  }
+  std::vector<QByteArray> strings;
+  strings.reserve(num_strings);
+  for (quint32 i = 0; i < num_strings; ++i) {
+    char *str = nullptr;
+    uint len = 0;
+    stream.readBytes(str, len);
+    strings.emplace_back(str ? str : "", static_cast<int>(len));
+    delete[] str;
+  }
+
+  auto root = vtkSmartPointer<vtkPVXMLElement>::New();
+  if (stream.status() != QDataStream::Ok || !read_element(stream, strings, root, 0)) {
+    vtkLog(ERROR, "Invalid clipboard contents.");
+    return nullptr;
+  }
+  return root;
+}
+
+vtkSmartPointer<vtkPVXMLElement> PipelineMimeData::state(const QMimeData *data) {
+  if (!data)
+    return nullptr;
+  if (data->hasFormat(mimeType)) {
+    if (auto root = decode(data->data(mimeType)))
+      return root;
+  }
+  if (!data->hasText())
+    return nullptr;
+  vtkLogScopeF(8, "PipelineMimeData: parse text");
+  std::string text = data->text().toStdString();
+  auto parser = vtkSmartPointer<vtkPVXMLParser>::New();
+  if (!parser->Parse(text.c_str())) {
+    vtkLog(ERROR, "Encountered exception during parsing clipboard contents:\n" + text);
+    return nullptr;
+  }
+  return parser->GetRootElement();
+}
+
+}
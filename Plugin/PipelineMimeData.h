@@ -0,0 +1,41 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINEMIMEDATA_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINEMIMEDATA_H_
+
+#include <vtkSmartPointer.h>
+#include <QMimeData>
+
+class vtkPVXMLElement;
+
+namespace ParaViewNetworkEditor {
+
+// Clipboard contents for copied parts of the pipeline.
+// Offers the state tree both in a compressed binary encoding (private MIME type) and as XML text,
+// for pasting into other applications or older versions. Both are only encoded when requested.
+class PipelineMimeData : public QMimeData {
+ public:
+  explicit PipelineMimeData(vtkPVXMLElement *state);
+  ~PipelineMimeData() override;
+
+  static const QString mimeType;
+
+  QStringList formats() const override;
+  bool hasFormat(const QString &mimetype) const override;
+
+  // Returns the state stored in mime data, or nullptr if it contains neither a binary nor a parsable text state.
+  static vtkSmartPointer<vtkPVXMLElement> state(const QMimeData *data);
+
+  static QByteArray encode(vtkPVXMLElement *state);
+  static vtkSmartPointer<vtkPVXMLElement> decode(const QByteArray &data);
+
+ protected:
+  QVariant retrieveData(const QString &mimetype, QVariant::Type type) const override;
+
+ private:
+  vtkSmartPointer<vtkPVXMLElement> state_;
+  mutable QByteArray binary_;
+  mutable QByteArray text_;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINEMIMEDATA_H_
@@ -3,6 +3,7 @@
 #include "SourceGraphicsItem.h"
 #include "ConnectionGraphicsItem.h"
 #include "utilpq.h"
+#include "perf_counters.h"
 
 #include <vtkSMParaViewPipelineControllerWithRendering.h>
 #include <vtkSMViewProxy.h>
@@ -101,6 +102,7 @@ void InputPortGraphicsItem::showToolTip(QGraphicsSceneHelpEvent *e) {
 }
 
 void InputPortGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *, QWidget *) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   p->save();
   p->setRenderHint(QPainter::Antialiasing, true);
   p->setRenderHint(QPainter::SmoothPixmapTransform, true);
@@ -203,6 +205,7 @@ void OutputPortGraphicsItem::showToolTip(QGraphicsSceneHelpEvent *e) {
 }
 
 void OutputPortGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *, QWidget *) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   p->save();
   p->setRenderHint(QPainter::Antialiasing, true);
   p->setRenderHint(QPainter::SmoothPixmapTransform, true);
@@ -237,6 +240,7 @@ PortConnectionIndicator::PortConnectionIndicator(
 }
 
 void PortConnectionIndicator::paint(QPainter *p, const QStyleOptionGraphicsItem *, QWidget *) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   p->save();
   p->setRenderHint(QPainter::Antialiasing, true);
 
@@ -1,7 +1,11 @@
 #include "SourceGraphicsItem.h"
 #include "PortGraphicsItem.h"
 #include "OutputPortStatusGraphicsItem.h"
+#include "NetworkEditor.h"
+#include "ExecutionProgress.h"
 #include "utilpq.h"
+#include "node_layout.h"
+#include "perf_counters.h"
 
 #include <pqPipelineSource.h>
 #include <pqPipelineFilter.h>
@@ -21,6 +25,8 @@
 #include <QTextCursor>
 #include <vtkSMSourceProxy.h>
 
+#include <algorithm>
+
 namespace ParaViewNetworkEditor {
 
 const QSizeF SourceGraphicsItem::size_ = {150.f, 50.f};
@@ -138,6 +144,7 @@ void SourceGraphicsItem::addOutport(int port) {
 }
 
 void SourceGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *options, QWidget *widget) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   if (!source_)
     return;
 
@@ -157,6 +164,18 @@ void SourceGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *opti
   if (modified) {
     borderColor = QColor("#FBBC05");
   }
+  qreal borderWidth = 2.0;
+  if (auto editor = this->getNetworkEditor()) {
+    QColor overlayColor = editor->overlayColor(source_);
+    if (overlayColor.isValid()) {
+      backgroundColor = overlayColor;
+    }
+    QColor highlightColor = editor->highlightColor(source_);
+    if (highlightColor.isValid()) {
+      borderColor = highlightColor;
+      borderWidth = 3.0;
+    }
+  }
   if (!visible) {
     backgroundColor.setAlpha(128);
     selectionColor.setAlpha(128);
@@ -167,10 +186,24 @@ void SourceGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *opti
   } else {
     p->setBrush(backgroundColor);
   }
-  p->setPen(QPen(QBrush(borderColor), 2.0));
+  p->setPen(QPen(QBrush(borderColor), borderWidth));
 
   p->drawRoundedRect(rect(), roundedCorners, roundedCorners);
 
+  auto progress = ExecutionProgress::instance();
+  if (progress->isExecuting(source_)) {
+    static constexpr qreal barMargin = 6.0;
+    static constexpr qreal barHeight = 3.0;
+    QRectF bar(rect().left() + barMargin, rect().bottom() - barMargin - barHeight,
+               rect().width() - 2 * barMargin, barHeight);
+    p->setPen(Qt::NoPen);
+    p->setBrush(QColor(0, 0, 0, 96));
+    p->drawRect(bar);
+    bar.setWidth(bar.width() * std::max(0., std::min(1., progress->progress(source_))));
+    p->setBrush(QColor("#4fc3f7"));
+    p->drawRect(bar);
+  }
+
   p->restore();
 }
 
@@ -224,25 +257,31 @@ QVariant SourceGraphicsItem::itemChange(GraphicsItemChange change, const QVarian
   return QGraphicsItem::itemChange(change, value);
 }
 
-void SourceGraphicsItem::storePosition() {
-  if (positionModified_) {
-    QPointF pos = this->scenePos();
-    source_->getProxy()->SetAnnotation("Node.x", std::to_string(pos.x()).c_str());
-    source_->getProxy()->SetAnnotation("Node.y", std::to_string(pos.y()).c_str());
-    positionModified_ = false;
-  }
+bool SourceGraphicsItem::storePosition() {
+  if (!positionModified_)
+    return false;
+  this->storePosition(this->scenePos());
+  positionModified_ = false;
+  return true;
+}
+
+void SourceGraphicsItem::storePosition(const QPointF &pos) {
+  node_layout::set_position(source_->getProxy(), pos);
+  storedPos_ = pos;
 }
 
 void SourceGraphicsItem::loadPosition() {
-  auto proxy = source_->getProxy();
-  if (proxy->HasAnnotation("Node.x") && proxy->HasAnnotation("Node.y")) {
-    QPointF pos;
-    pos.setX(std::stof(proxy->GetAnnotation("Node.x")));
-    pos.setY(std::stof(proxy->GetAnnotation("Node.y")));
+  QPointF pos;
+  if (node_layout::get_position(source_->getProxy(), pos)) {
     this->setPos(pos);
+    storedPos_ = pos;
   }
 }
 
+QPointF SourceGraphicsItem::storedPosition() const {
+  return storedPos_;
+}
+
 InputPortGraphicsItem *SourceGraphicsItem::getInputPortGraphicsItem(int port) const {
   if ((port < 0) || ((size_t) port >= inportItems_.size()))
     return nullptr;
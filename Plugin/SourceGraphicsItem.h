@@ -34,8 +34,11 @@ class SourceGraphicsItem : public QObject, public EditorGraphicsItem, public Lab
   InputPortGraphicsItem *getInputPortGraphicsItem(int) const;
   OutputPortGraphicsItem *getOutputPortGraphicsItem(int) const;
 
-  virtual void storePosition();
+  // Writes the position to the proxy annotations if it was changed. Returns true if anything was stored.
+  virtual bool storePosition();
+  void storePosition(const QPointF &pos);
   virtual void loadPosition();
+  QPointF storedPosition() const;
 
   void showToolTip(QGraphicsSceneHelpEvent *e) override;
 
@@ -65,6 +68,7 @@ class SourceGraphicsItem : public QObject, public EditorGraphicsItem, public Lab
   std::vector<OutputPortGraphicsItem *> outportItems_;
 
   bool positionModified_ = false;
+  QPointF storedPos_;
 
 };
 
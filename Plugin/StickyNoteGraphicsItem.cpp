@@ -1,9 +1,14 @@
 #include "StickyNoteGraphicsItem.h"
+#include "NetworkEditor.h"
+#include "vtkNodeGeometryUndoElement.h"
+#include "node_layout.h"
+#include "perf_counters.h"
 
 #include <pqPipelineSource.h>
 #include <pqUndoStack.h>
 #include <vtkSMProxy.h>
 #include <vtkSMPropertyHelper.h>
+#include <vtkSmartPointer.h>
 
 #include <QAbstractTextDocumentLayout>
 #include <QPainter>
@@ -31,6 +36,7 @@ StickyNoteGraphicsItem::StickyNoteGraphicsItem(pqPipelineSource* source) {
 StickyNoteGraphicsItem::~StickyNoteGraphicsItem() = default;
 
 void StickyNoteGraphicsItem::paint(QPainter *p, const QStyleOptionGraphicsItem *options, QWidget *widget) {
+  perf_counters::increment(perf_counters::ITEMS_PAINTED);
   if (!source_)
     return;
   bool modified = source_->modifiedState() != pqProxy::UNMODIFIED;
@@ -277,11 +283,16 @@ void StickyNoteGraphicsItem::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
     // this->storePosition();
     if (source_) {
       if (auto proxy = source_->getProxy()) {
-        BEGIN_UNDO_SET("Resize Sticky Note");
+        auto undo_element = vtkSmartPointer<vtkNodeGeometryUndoElement>::New();
         QRectF rect = this->rect();
-        proxy->SetAnnotation("Node.width", std::to_string(rect.width()).c_str());
-        proxy->SetAnnotation("Node.height", std::to_string(rect.height()).c_str());
-        END_UNDO_SET();
+        node_layout::set_size(proxy, rect.size());
+        QSizeF delta = rect.size() - storedSize_;
+        if (!delta.isNull())
+          undo_element->AddNode(proxy->GetGlobalID(), 0., 0., delta.width(), delta.height());
+        storedSize_ = rect.size();
+        if (auto editor = qobject_cast<NetworkEditor *>(this->scene())) {
+          editor->addUndoElement("Resize Sticky Note", undo_element);
+        }
       }
     }
   } else {
@@ -302,8 +313,8 @@ void StickyNoteGraphicsItem::hoverMoveEvent(QGraphicsSceneHoverEvent *event) {
   SourceGraphicsItem::hoverMoveEvent(event);
 }
 
-void StickyNoteGraphicsItem::storePosition() {
-  SourceGraphicsItem::storePosition();
+bool StickyNoteGraphicsItem::storePosition() {
+  return SourceGraphicsItem::storePosition();
 }
 
 void StickyNoteGraphicsItem::loadSize() {
@@ -312,13 +323,13 @@ void StickyNoteGraphicsItem::loadSize() {
   if (auto proxy = source_->getProxy()) {
     QRectF rect = this->rect();
     this->prepareGeometryChange();
-    try {
-      rect.setWidth(std::stof(proxy->GetAnnotation("Node.width")));
-      rect.setHeight(std::stof(proxy->GetAnnotation("Node.height")));
-    } catch (...) {
+    QSizeF size;
+    if (node_layout::get_size(proxy, size)) {
+      rect.setSize(size);
     }
     this->setRect(rect);
     this->updateHandles();
+    storedSize_ = rect.size();
   }
 }
 
@@ -12,7 +12,7 @@ class StickyNoteGraphicsItem : public SourceGraphicsItem {
   virtual ~StickyNoteGraphicsItem();
 
   void showToolTip(QGraphicsSceneHelpEvent *e) override;
-  void storePosition() override;
+  bool storePosition() override;
   void loadPosition() override;
  protected:
   void paint(QPainter *p, const QStyleOptionGraphicsItem *options, QWidget *widget) override;
@@ -26,6 +26,7 @@ class StickyNoteGraphicsItem : public SourceGraphicsItem {
   Handle handle_selected_ {HANDLE_NONE};
   QPointF mouse_press_pos_;
   QRectF mouse_press_rect_;
+  QSizeF storedSize_;
   QRectF handles_[3];
   std::vector<QCursor> handle_cursors_;
 
@@ -0,0 +1,145 @@
+#include "chrome_trace.h"
+
+#include <vtkLogger.h>
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace ParaViewNetworkEditor {
+namespace chrome_trace {
+
+namespace {
+
+const char *callback_id = "NetworkEditorChromeTrace";
+
+// Each slot is guarded by its own sequence number, written odd before and even after the event, so that a
+// reader can skip slots that are being overwritten without writers ever waiting.
+struct Slot {
+  std::atomic<std::uint64_t> sequence{0};
+  char phase = 0;
+  std::uint64_t thread = 0;
+  std::int64_t nanoseconds = 0;
+  char name[128] = {};
+};
+
+struct RingBuffer {
+  explicit RingBuffer(size_t capacity) : slots(new Slot[capacity]), capacity(capacity) {}
+  std::unique_ptr<Slot[]> slots;
+  const size_t capacity;
+  std::atomic<std::uint64_t> head{0};
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+// Replaced only by start() while no callback is registered. vtkLogger runs the callbacks under the same mutex
+// that RemoveCallback takes, so no callback still writes to the previous buffer once stop() returned.
+std::unique_ptr<RingBuffer> &buffer() {
+  static std::unique_ptr<RingBuffer> buffer;
+  return buffer;
+}
+bool is_recording = false;
+
+void add_event(RingBuffer *buffer, char phase, const char *name) {
+  const auto now = std::chrono::steady_clock::now();
+  const std::uint64_t index = buffer->head.fetch_add(1, std::memory_order_relaxed);
+  Slot &slot = buffer->slots[index % buffer->capacity];
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.phase = phase;
+  slot.thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+  slot.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(now - buffer->start).count();
+  std::strncpy(slot.name, name ? name : "", sizeof(slot.name) - 1);
+  slot.name[sizeof(slot.name) - 1] = '\0';
+  slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+void log_callback(void *user_data, const vtkLogger::Message &message) {
+  auto buffer = static_cast<RingBuffer *>(user_data);
+  // scopes are logged as "{ name" when entered and "} duration: name" when left
+  const char *prefix = message.prefix ? message.prefix : "";
+  if (prefix[0] == '{') {
+    add_event(buffer, 'B', message.message);
+  } else if (prefix[0] == '}') {
+    add_event(buffer, 'E', "");
+  } else {
+    add_event(buffer, 'i', message.message);
+  }
+}
+
+}
+
+void start(size_t capacity) {
+  if (is_recording || capacity == 0)
+    return;
+  buffer().reset(new RingBuffer(capacity));
+  vtkLogger::AddCallback(callback_id, &log_callback, buffer().get(), vtkLogger::VERBOSITY_8);
+  is_recording = true;
+}
+
+void stop() {
+  if (!is_recording)
+    return;
+  vtkLogger::RemoveCallback(callback_id);
+  is_recording = false;
+}
+
+bool recording() {
+  return is_recording;
+}
+
+bool write(const QString &path) {
+  QJsonArray events;
+  if (buffer()) {
+    const RingBuffer &recorded = *buffer();
+    const std::uint64_t head = recorded.head.load(std::memory_order_acquire);
+    const std::uint64_t first = head > recorded.capacity ? head - recorded.capacity : 0;
+    const qint64 pid = QCoreApplication::applicationPid();
+    for (std::uint64_t index = first; index < head; ++index) {
+      const Slot &slot = recorded.slots[index % recorded.capacity];
+      if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2)
+        continue;
+      Slot copy;
+      copy.phase = slot.phase;
+      copy.thread = slot.thread;
+      copy.nanoseconds = slot.nanoseconds;
+      std::memcpy(copy.name, slot.name, sizeof(copy.name));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != 2 * index + 2)
+        continue;
+
+      QJsonObject event;
+      event["ph"] = QString(QLatin1Char(copy.phase));
+      event["ts"] = copy.nanoseconds * 1e-3;
+      event["pid"] = pid;
+      // thread ids are hashed, JSON numbers are only exact up to 2^53
+      event["tid"] = static_cast<qint64>(copy.thread & ((std::uint64_t(1) << 53) - 1));
+      if (copy.phase != 'E')
+        event["name"] = QString::fromUtf8(copy.name);
+      if (copy.phase == 'i')
+        event["s"] = "t";
+      events.append(event);
+    }
+  }
+
+  QJsonObject root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = "ms";
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+  const QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Compact);
+  return file.write(data) == data.size();
+}
+
+}
+}
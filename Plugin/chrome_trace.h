@@ -0,0 +1,26 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_CHROME_TRACE_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_CHROME_TRACE_H_
+
+#include <QString>
+
+#include <cstddef>
+
+namespace ParaViewNetworkEditor {
+namespace chrome_trace {
+
+// Records the vtkLogger scopes and messages up to verbosity 8 while started, which includes all scopes of the
+// editor. ParaView's own scopes are included when their categories are lowered to 8 as well, e.g. with
+// PARAVIEW_LOG_PIPELINE_VERBOSITY=8. Events go into a lock-free ring buffer of the given number of events, so
+// that a recording keeps the most recent events at a fixed cost.
+void start(size_t capacity = 1 << 16);
+void stop();
+bool recording();
+
+// Writes the recorded events as Chrome trace event JSON, for chrome://tracing or Perfetto. Can be called while
+// recording. Returns false if the file could not be written.
+bool write(const QString &path);
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_CHROME_TRACE_H_
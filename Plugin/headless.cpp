@@ -0,0 +1,35 @@
+#include "headless.h"
+
+#include <pqObjectBuilder.h>
+#include <pqPVApplicationCore.h>
+#include <pqServer.h>
+#include <pqServerResource.h>
+#include <vtkSMPluginManager.h>
+#include <vtkSMProxyManager.h>
+
+#include <iostream>
+
+namespace ParaViewNetworkEditor {
+namespace headless {
+
+void use_offscreen_platform() {
+  if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+}
+
+pqServer *start_session(pqPVApplicationCore &core, const QString &plugin) {
+  // the plugin registers the proxies used in states saved with the network editor, before the session is created
+  if (!vtkSMProxyManager::GetProxyManager()->GetPluginManager()->LoadLocalPlugin(plugin.toUtf8().constData())) {
+    std::cerr << "Could not load plugin " << plugin.toStdString() << std::endl;
+    return nullptr;
+  }
+  pqServer *server = core.getObjectBuilder()->createServer(pqServerResource("builtin:"));
+  if (!server) {
+    std::cerr << "Could not create builtin session" << std::endl;
+  }
+  return server;
+}
+
+}
+}
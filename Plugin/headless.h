@@ -0,0 +1,23 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_HEADLESS_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_HEADLESS_H_
+
+#include <QString>
+
+class pqPVApplicationCore;
+class pqServer;
+
+namespace ParaViewNetworkEditor {
+namespace headless {
+
+// Selects the offscreen Qt platform unless QT_QPA_PLATFORM is set. Has to be called before the QApplication is
+// created.
+void use_offscreen_platform();
+
+// Loads the network editor plugin for its proxy definitions and connects to a builtin session. Returns nullptr
+// and reports the error on stderr if either fails.
+pqServer *start_session(pqPVApplicationCore &core, const QString &plugin);
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_HEADLESS_H_
@@ -0,0 +1,132 @@
+#include "interaction_trace.h"
+
+#include <vtkLogger.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace ParaViewNetworkEditor {
+namespace interaction_trace {
+
+namespace {
+
+const int format_version = 1;
+
+const std::vector<std::pair<QEvent::Type, QString>> &type_names() {
+  static const std::vector<std::pair<QEvent::Type, QString>> names = {
+      {QEvent::MouseButtonPress, "press"},
+      {QEvent::MouseButtonRelease, "release"},
+      {QEvent::MouseButtonDblClick, "double_click"},
+      {QEvent::MouseMove, "move"},
+      {QEvent::Wheel, "wheel"},
+      {QEvent::KeyPress, "key_press"},
+      {QEvent::KeyRelease, "key_release"},
+  };
+  return names;
+}
+
+QEvent::Type type_from_name(const QString &name) {
+  for (const auto &kv : type_names()) {
+    if (kv.second == name)
+      return kv.first;
+  }
+  return QEvent::None;
+}
+
+}
+
+QString type_name(QEvent::Type type) {
+  for (const auto &kv : type_names()) {
+    if (kv.first == type)
+      return kv.second;
+  }
+  return QString();
+}
+
+bool save(const Trace &trace, const QString &path) {
+  QJsonArray events;
+  for (const Event &event : trace.events) {
+    QJsonObject json;
+    json["t"] = event.time;
+    json["type"] = type_name(event.type);
+    json["modifiers"] = event.modifiers;
+    if (event.type == QEvent::KeyPress || event.type == QEvent::KeyRelease) {
+      json["key"] = event.key;
+      json["text"] = event.text;
+    } else {
+      json["pos"] = QJsonArray{event.pos.x(), event.pos.y()};
+      json["button"] = event.button;
+      json["buttons"] = event.buttons;
+      if (event.type == QEvent::Wheel)
+        json["delta"] = QJsonArray{event.angle_delta.x(), event.angle_delta.y()};
+    }
+    events.append(json);
+  }
+
+  const QTransform &m = trace.transform;
+  QJsonObject root;
+  root["version"] = format_version;
+  root["view"] = QJsonArray{trace.view_size.width(), trace.view_size.height()};
+  root["transform"] = QJsonArray{m.m11(), m.m12(), m.m13(), m.m21(), m.m22(), m.m23(), m.m31(), m.m32(), m.m33()};
+  root["center"] = QJsonArray{trace.center.x(), trace.center.y()};
+  root["events"] = events;
+
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+  const QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Compact);
+  return file.write(data) == data.size();
+}
+
+bool load(const QString &path, Trace &trace) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+  QJsonParseError error;
+  const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+  if (document.isNull()) {
+    vtkLog(ERROR, "Invalid interaction trace " << path.toStdString() << ": " << error.errorString().toStdString());
+    return false;
+  }
+  const QJsonObject root = document.object();
+  if (root["version"].toInt() != format_version) {
+    vtkLog(ERROR, "Unknown interaction trace version in " << path.toStdString());
+    return false;
+  }
+
+  const QJsonArray view = root["view"].toArray();
+  trace.view_size = QSize(view.at(0).toInt(), view.at(1).toInt());
+  const QJsonArray m = root["transform"].toArray();
+  if (m.size() == 9) {
+    trace.transform = QTransform(m[0].toDouble(), m[1].toDouble(), m[2].toDouble(), m[3].toDouble(),
+                                 m[4].toDouble(), m[5].toDouble(), m[6].toDouble(), m[7].toDouble(), m[8].toDouble());
+  }
+  const QJsonArray center = root["center"].toArray();
+  trace.center = QPointF(center.at(0).toDouble(), center.at(1).toDouble());
+
+  trace.events.clear();
+  for (const QJsonValue &value : root["events"].toArray()) {
+    const QJsonObject json = value.toObject();
+    Event event;
+    event.type = type_from_name(json["type"].toString());
+    if (event.type == QEvent::None)
+      continue;
+    event.time = json["t"].toDouble();
+    event.modifiers = json["modifiers"].toInt();
+    event.key = json["key"].toInt();
+    event.text = json["text"].toString();
+    const QJsonArray pos = json["pos"].toArray();
+    event.pos = QPointF(pos.at(0).toDouble(), pos.at(1).toDouble());
+    event.button = json["button"].toInt();
+    event.buttons = json["buttons"].toInt();
+    const QJsonArray delta = json["delta"].toArray();
+    event.angle_delta = QPoint(delta.at(0).toInt(), delta.at(1).toInt());
+    trace.events.push_back(event);
+  }
+  return true;
+}
+
+}
+}
@@ -0,0 +1,50 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_INTERACTION_TRACE_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_INTERACTION_TRACE_H_
+
+#include <QEvent>
+#include <QPoint>
+#include <QPointF>
+#include <QSize>
+#include <QString>
+#include <QTransform>
+
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+namespace interaction_trace {
+
+// Input event of the network editor view. Positions are in scene coordinates, so that a trace replays on the
+// same nodes regardless of the size, zoom and scroll position of the view.
+struct Event {
+  // milliseconds since the start of the recording
+  double time = 0.;
+  // one of the mouse, wheel or key event types
+  QEvent::Type type = QEvent::None;
+  QPointF pos;
+  int button = 0;
+  int buttons = 0;
+  int modifiers = 0;
+  int key = 0;
+  QString text;
+  QPoint angle_delta;
+};
+
+struct Trace {
+  // view at the start of the recording
+  QSize view_size;
+  QTransform transform;
+  QPointF center;
+  std::vector<Event> events;
+};
+
+// Name of a recorded event type in the JSON traces, empty for other types.
+QString type_name(QEvent::Type type);
+
+// Traces are stored as JSON. Both return false if the file could not be written or read.
+bool save(const Trace &trace, const QString &path);
+bool load(const QString &path, Trace &trace);
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_INTERACTION_TRACE_H_
@@ -0,0 +1,332 @@
+// Benchmark of the network editor on generated pipelines, without a GUI session.
+//
+//   pvnetworkbench [--nodes N] [--fan-in K] [--fan-out K] [--depth D] [--sticky-notes S] [--repeat R] [-o FILE]
+//
+// The pipeline is built from cheap, never executed sources in a builtin session: SphereSource on the first level,
+// then PassArrays, or Append for a fan-in above one. Each filter reads fan-in consecutive outputs of the previous
+// level and fan-out consecutive filters share the same inputs. Results are written as JSON, with all samples in
+// milliseconds.
+
+#include "NetworkEditor.h"
+#include "NetworkEditorView.h"
+#include "PipelineMimeData.h"
+#include "SourceGraphicsItem.h"
+#include "headless.h"
+#include "utilpq.h"
+
+#include <pqActiveObjects.h>
+#include <pqObjectBuilder.h>
+#include <pqOutputPort.h>
+#include <pqPVApplicationCore.h>
+#include <pqPipelineSource.h>
+#include <pqProxySelection.h>
+#include <pqServer.h>
+#include <pqUndoStack.h>
+#include <vtkPVVersion.h>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMimeData>
+#include <QPainter>
+#include <QScrollBar>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <vector>
+
+namespace {
+
+using namespace ParaViewNetworkEditor;
+
+struct Parameters {
+  int nodes = 500;
+  int fan_in = 1;
+  int fan_out = 1;
+  int depth = 10;
+  int sticky_notes = 0;
+  int repeat = 5;
+};
+
+class Results {
+ public:
+  // Runs setup, then times body, repeat times. Only the body is timed.
+  void measure(const QString &name, int repeat, const std::function<void()> &setup, const std::function<void()> &body) {
+    std::vector<double> samples;
+    for (int i = 0; i < repeat; ++i) {
+      if (setup)
+        setup();
+      auto start = std::chrono::steady_clock::now();
+      body();
+      auto end = std::chrono::steady_clock::now();
+      samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    this->add(name, samples);
+  }
+
+  void add(const QString &name, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    QJsonArray values;
+    for (double sample : samples)
+      values.append(sample);
+    QJsonObject result;
+    result["name"] = name;
+    result["samples"] = values;
+    if (!samples.empty()) {
+      result["min"] = samples.front();
+      result["median"] = samples[samples.size() / 2];
+      result["mean"] = std::accumulate(samples.begin(), samples.end(), 0.) / samples.size();
+    }
+    results_.append(result);
+    std::cerr << name.toStdString() << ": " << (samples.empty() ? 0. : samples[samples.size() / 2]) << " ms"
+              << std::endl;
+  }
+
+  const QJsonArray &json() const { return results_; }
+
+ private:
+  QJsonArray results_;
+};
+
+std::vector<pqPipelineSource *> generate(const Parameters &parameters, pqServer *server) {
+  pqObjectBuilder *builder = pqApplicationCore::instance()->getObjectBuilder();
+  std::vector<pqPipelineSource *> sources;
+  std::vector<pqPipelineSource *> previous, current;
+  const int width = (parameters.nodes + parameters.depth - 1) / parameters.depth;
+  for (int remaining = parameters.nodes; remaining > 0; remaining -= width) {
+    const int n = std::min(width, remaining);
+    for (int i = 0; i < n; ++i) {
+      if (previous.empty()) {
+        current.push_back(builder->createSource("sources", "SphereSource", server));
+        continue;
+      }
+      QList<pqOutputPort *> inputs;
+      const int first = (i / parameters.fan_out) * parameters.fan_in;
+      for (int k = 0; k < std::min<int>(parameters.fan_in, static_cast<int>(previous.size())); ++k) {
+        inputs.push_back(previous[(first + k) % previous.size()]->getOutputPort(0));
+      }
+      if (inputs.size() > 1) {
+        QMap<QString, QList<pqOutputPort *>> named_inputs;
+        named_inputs["Input"] = inputs;
+        current.push_back(builder->createFilter("filters", "Append", named_inputs, server));
+      } else {
+        current.push_back(builder->createFilter("filters", "PassArrays", inputs.front()->getSource()));
+      }
+    }
+    sources.insert(sources.end(), current.begin(), current.end());
+    previous.swap(current);
+    current.clear();
+  }
+  for (int i = 0; i < parameters.sticky_notes; ++i) {
+    sources.push_back(builder->createSource("sources", "NetworkEditorStickyNote", server));
+  }
+  return sources;
+}
+
+void select_sources(NetworkEditor &editor, const std::set<pqPipelineSource *> &sources) {
+  editor.clearSelection();
+  for (QGraphicsItem *item : editor.items()) {
+    auto source = qgraphicsitem_cast<SourceGraphicsItem *>(item);
+    if (source && sources.count(source->getSource()))
+      source->setSelected(true);
+  }
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  using namespace ParaViewNetworkEditor;
+
+  headless::use_offscreen_platform();
+  QApplication app(argc, argv);
+  QApplication::setApplicationName("pvnetworkbench");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Benchmarks the network editor on a generated pipeline.");
+  parser.addHelpOption();
+  QCommandLineOption nodes_option("nodes", "Number of sources and filters (default 500).", "n", "500");
+  QCommandLineOption fan_in_option("fan-in", "Inputs of each filter (default 1).", "k", "1");
+  QCommandLineOption fan_out_option("fan-out", "Filters sharing the same inputs (default 1).", "k", "1");
+  QCommandLineOption depth_option("depth", "Number of levels (default 10).", "d", "10");
+  QCommandLineOption sticky_notes_option("sticky-notes", "Number of sticky notes (default 0).", "n", "0");
+  QCommandLineOption repeat_option("repeat", "Samples of each measurement (default 5).", "n", "5");
+  QCommandLineOption output_option(QStringList{"o", "output"}, "JSON file of the results, default stdout.", "file");
+  QCommandLineOption plugin_option("plugin", "Network editor plugin that provides the proxy definitions.", "file",
+                                   NETWORKEDITOR_PLUGIN_FILE);
+  parser.addOptions({nodes_option, fan_in_option, fan_out_option, depth_option, sticky_notes_option, repeat_option,
+                     output_option, plugin_option});
+  parser.process(app);
+
+  Parameters parameters;
+  parameters.nodes = parser.value(nodes_option).toInt();
+  parameters.fan_in = parser.value(fan_in_option).toInt();
+  parameters.fan_out = parser.value(fan_out_option).toInt();
+  parameters.depth = parser.value(depth_option).toInt();
+  parameters.sticky_notes = parser.value(sticky_notes_option).toInt();
+  parameters.repeat = parser.value(repeat_option).toInt();
+  if (parameters.nodes < 1 || parameters.fan_in < 1 || parameters.fan_out < 1 || parameters.depth < 1
+      || parameters.sticky_notes < 0 || parameters.repeat < 1) {
+    std::cerr << "Invalid parameters" << std::endl;
+    return 1;
+  }
+
+  // ParaView must not see the arguments of this tool
+  int core_argc = 1;
+  pqPVApplicationCore core(core_argc, argv);
+  pqServer *server = headless::start_session(core, parser.value(plugin_option));
+  if (!server) {
+    return 1;
+  }
+  // undo sets are recorded like in the GUI
+  auto undo_stack = new pqUndoStack(false, nullptr, &core);
+  core.setUndoStack(undo_stack);
+
+  Results results;
+  const int repeat = parameters.repeat;
+
+  std::vector<pqPipelineSource *> sources;
+  results.measure("generate", 1, nullptr, [&]() {
+    sources = generate(parameters, server);
+    QApplication::processEvents();
+  });
+  const std::set<pqPipelineSource *> generated(sources.begin(), sources.end());
+  undo_stack->clear();
+
+  results.measure("construct", repeat, nullptr, [&]() {
+    NetworkEditor editor;
+  });
+
+  NetworkEditor editor;
+  NetworkEditorView view(&editor);
+  view.resize(1600, 1000);
+  view.show();
+  QApplication::processEvents();
+
+  // all nodes, scaled into a fixed size image
+  results.measure("paint_full", repeat, nullptr, [&]() {
+    QImage image(2048, 2048, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&image);
+    editor.render(&painter, QRectF(image.rect()), editor.getSourcesBoundingRect());
+  });
+
+  view.fitNetwork();
+  view.setTransform(QTransform());
+  int direction = 1;
+  results.measure("pan_frame", repeat * 10, [&]() {
+    QScrollBar *bar = view.horizontalScrollBar();
+    if (bar->value() + direction * 100 > bar->maximum() || bar->value() + direction * 100 < bar->minimum())
+      direction = -direction;
+    bar->setValue(bar->value() + direction * 100);
+  }, [&]() {
+    view.viewport()->repaint();
+  });
+
+  bool zoom_in = true;
+  results.measure("zoom_frame", repeat * 10, [&]() {
+    view.scale(zoom_in ? 1.25 : 0.8, zoom_in ? 1.25 : 0.8);
+    zoom_in = !zoom_in;
+  }, [&]() {
+    view.viewport()->repaint();
+  });
+  view.fitNetwork();
+
+  results.measure("select_editor_to_paraview", repeat, [&]() {
+    editor.clearSelection();
+  }, [&]() {
+    editor.selectAll();
+  });
+
+  results.measure("select_paraview_to_editor", repeat, [&]() {
+    pqActiveObjects::instance().setSelection(pqProxySelection(), nullptr);
+  }, [&]() {
+    pqProxySelection selection;
+    for (pqPipelineSource *source : sources)
+      selection.insert(source);
+    pqActiveObjects::instance().setSelection(selection, sources.front());
+  });
+
+  // the binary clipboard format is encoded when requested, like when pasting into another instance
+  int clipboard_bytes = 0;
+  results.measure("copy", repeat, [&]() {
+    editor.selectAll();
+  }, [&]() {
+    editor.copy();
+    clipboard_bytes = QApplication::clipboard()->mimeData()->data(PipelineMimeData::mimeType).size();
+  });
+
+  std::set<pqPipelineSource *> pasted;
+  std::vector<double> paste_samples, delete_samples;
+  for (int i = 0; i < repeat; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    editor.paste(0.f, 0.f, false);
+    QApplication::processEvents();
+    auto end = std::chrono::steady_clock::now();
+    paste_samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+    pasted.clear();
+    for (pqPipelineSource *source : utilpq::get_sources()) {
+      if (!generated.count(source))
+        pasted.insert(source);
+    }
+    select_sources(editor, pasted);
+    start = std::chrono::steady_clock::now();
+    editor.deleteSelected();
+    QApplication::processEvents();
+    end = std::chrono::steady_clock::now();
+    delete_samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  results.add("paste", paste_samples);
+  results.add("delete", delete_samples);
+
+#ifdef ENABLE_GRAPHVIZ
+  results.measure("layout", repeat, nullptr, [&]() {
+    editor.computeGraphLayout();
+  });
+#endif
+
+  QJsonObject json_parameters;
+  json_parameters["nodes"] = parameters.nodes;
+  json_parameters["fan_in"] = parameters.fan_in;
+  json_parameters["fan_out"] = parameters.fan_out;
+  json_parameters["depth"] = parameters.depth;
+  json_parameters["sticky_notes"] = parameters.sticky_notes;
+  json_parameters["repeat"] = parameters.repeat;
+
+  QJsonObject environment;
+  environment["paraview"] = PARAVIEW_VERSION_FULL;
+  environment["qt"] = qVersion();
+  environment["platform"] = QGuiApplication::platformName();
+#ifdef ENABLE_GRAPHVIZ
+  environment["graphviz"] = true;
+#else
+  environment["graphviz"] = false;
+#endif
+
+  QJsonObject root;
+  root["parameters"] = json_parameters;
+  root["environment"] = environment;
+  root["clipboard_bytes"] = clipboard_bytes;
+  root["results"] = results.json();
+  const QByteArray json = QJsonDocument(root).toJson();
+
+  if (!parser.isSet(output_option)) {
+    std::cout << json.constData();
+    return 0;
+  }
+  QFile file(parser.value(output_option));
+  if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+    std::cerr << "Could not write " << file.fileName().toStdString() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Command line tool that exports network diagrams of state files, without a GUI session.
+//
+//   pvnetworkexport [--layout] [--scale S] [--transparent] [--output-dir DIR] [--suffix SUFFIX] state.pvsm...
+//
+// All state files are loaded one after another into the same builtin session. Qt runs on the offscreen platform
+// unless QT_QPA_PLATFORM is set; views are created by the state, but nothing is rendered.
+
+#include "NetworkEditor.h"
+#include "headless.h"
+#include "pipeline_screenshot.h"
+#include "vtkPVNetworkEditorSettings.h"
+
+#include <pqPVApplicationCore.h>
+#include <pqServer.h>
+#include <vtkLogger.h>
+#include <vtkNew.h>
+#include <vtkSMParaViewPipelineController.h>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+
+#include <iostream>
+
+namespace {
+
+QString output_path(const QString &state, const QString &output_dir, const QString &suffix) {
+  QFileInfo info(state);
+  QDir dir = output_dir.isEmpty() ? info.dir() : QDir(output_dir);
+  return dir.filePath(info.completeBaseName() + suffix);
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  using namespace ParaViewNetworkEditor;
+
+  headless::use_offscreen_platform();
+  QApplication app(argc, argv);
+  QApplication::setApplicationName("pvnetworkexport");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Exports the network editor diagrams of ParaView state files as PNG or SVG.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("states", "State files (.pvsm) to export.", "state.pvsm...");
+  QCommandLineOption layout_option("layout", "Compute a graph layout before exporting (requires graphviz).");
+  QCommandLineOption scale_option("scale", "Scale of the image, defaults to the network editor setting.", "scale");
+  QCommandLineOption transparent_option("transparent", "Export with a transparent background.");
+  QCommandLineOption output_option(QStringList{"o", "output-dir"},
+                                   "Directory of the exported images, defaults to the directory of each state file.",
+                                   "dir");
+  QCommandLineOption suffix_option("suffix", "Replaces the extension of the state file, .svg exports SVG, "
+                                             "anything else PNG. Defaults to the network editor setting.", "suffix");
+  QCommandLineOption plugin_option("plugin", "Network editor plugin that provides the proxy definitions.", "file",
+                                   NETWORKEDITOR_PLUGIN_FILE);
+  parser.addOptions({layout_option, scale_option, transparent_option, output_option, suffix_option, plugin_option});
+  parser.process(app);
+
+  const QStringList states = parser.positionalArguments();
+  if (states.isEmpty()) {
+    parser.showHelp(1);
+  }
+
+  // ParaView must not see the arguments of this tool
+  int core_argc = 1;
+  pqPVApplicationCore core(core_argc, argv);
+
+  pqServer *server = headless::start_session(core, parser.value(plugin_option));
+  if (!server) {
+    return 1;
+  }
+
+  auto settings = vtkPVNetworkEditorSettings::GetInstance();
+  double scale = settings->GetPipelineScreenshotScale();
+  if (parser.isSet(scale_option)) {
+    bool ok = false;
+    scale = parser.value(scale_option).toDouble(&ok);
+    if (!ok || scale <= 0.) {
+      std::cerr << "Invalid scale " << parser.value(scale_option).toStdString() << std::endl;
+      return 1;
+    }
+  }
+  const bool transparent = parser.isSet(transparent_option) || settings->GetPipelineScreenshotTransparency();
+  const QString suffix = parser.isSet(suffix_option) ? parser.value(suffix_option)
+                                                       : QString::fromStdString(settings->GetAutoSavePipelineSuffix());
+#ifndef ENABLE_GRAPHVIZ
+  if (parser.isSet(layout_option)) {
+    std::cerr << "Built without graphviz, states are exported with their saved layout" << std::endl;
+  }
+#endif
+
+  // the editor follows the server manager model like in the GUI, but is never shown in a view
+  NetworkEditor editor;
+
+  int failed = 0;
+  bool first = true;
+  for (const QString &state : states) {
+    if (!QFileInfo(state).isFile()) {
+      std::cerr << "No such state file " << state.toStdString() << std::endl;
+      ++failed;
+      continue;
+    }
+    if (!first) {
+      vtkNew<vtkSMParaViewPipelineController> controller;
+      controller->ResetSession(server->session());
+    }
+    first = false;
+
+    vtkLogScopeF(INFO, "export %s", state.toUtf8().constData());
+    core.loadState(state.toUtf8().constData(), server);
+    // layout saves and data information are scheduled on the event loop
+    QApplication::processEvents();
+#ifdef ENABLE_GRAPHVIZ
+    if (parser.isSet(layout_option)) {
+      editor.computeGraphLayout();
+    }
+#endif
+
+    const QString path = output_path(state, parser.value(output_option), suffix);
+    if (!pipeline_screenshot::save(&editor, path, scale, transparent)) {
+      std::cerr << "Could not export " << state.toStdString() << " to " << path.toStdString() << std::endl;
+      ++failed;
+      continue;
+    }
+    std::cout << path.toStdString() << std::endl;
+  }
+  return failed ? 1 : 0;
+}
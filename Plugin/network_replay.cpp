@@ -0,0 +1,258 @@
+// Replays an interaction trace recorded in the network editor on a state file, without a GUI session.
+//
+//   pvnetworkreplay [--realtime] [--repeat N] [-o FILE] state.pvsm trace.json
+//
+// The state is loaded into a builtin session and shown in a view of the recorded size. Each event is sent to the
+// view and its processing time is the event latency; the update of the view that follows is timed as a frame.
+// Without --realtime, events are sent as fast as possible. Latencies and frame times are written as JSON
+// histograms in milliseconds.
+
+#include "NetworkEditor.h"
+#include "NetworkEditorView.h"
+#include "headless.h"
+#include "interaction_trace.h"
+
+#include <pqPVApplicationCore.h>
+#include <pqServer.h>
+#include <pqUndoStack.h>
+#include <vtkNew.h>
+#include <vtkSMParaViewPipelineController.h>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMouseEvent>
+#include <QTest>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+using namespace ParaViewNetworkEditor;
+
+// upper bounds of the histogram buckets in milliseconds, the last bucket is unbounded
+const std::vector<double> &bucket_bounds() {
+  static const std::vector<double> bounds = {0.1, 0.25, 0.5, 1., 2., 4., 8., 16., 33., 66., 133., 266.};
+  return bounds;
+}
+
+QJsonObject histogram(std::vector<double> samples) {
+  QJsonObject json;
+  json["count"] = static_cast<int>(samples.size());
+  if (samples.empty())
+    return json;
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&samples](double p) {
+    return samples[std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()))];
+  };
+  json["mean"] = std::accumulate(samples.begin(), samples.end(), 0.) / samples.size();
+  json["p50"] = percentile(0.5);
+  json["p90"] = percentile(0.9);
+  json["p99"] = percentile(0.99);
+  json["max"] = samples.back();
+
+  const std::vector<double> &bounds = bucket_bounds();
+  std::vector<int> counts(bounds.size() + 1, 0);
+  for (double sample : samples) {
+    ++counts[std::lower_bound(bounds.begin(), bounds.end(), sample) - bounds.begin()];
+  }
+  QJsonArray json_bounds, json_counts;
+  for (double bound : bounds)
+    json_bounds.append(bound);
+  for (int count : counts)
+    json_counts.append(count);
+  json["bounds"] = json_bounds;
+  json["counts"] = json_counts;
+  return json;
+}
+
+class PaintCounter : public QObject {
+ public:
+  using QObject::QObject;
+  int paints = 0;
+
+ protected:
+  bool eventFilter(QObject *, QEvent *event) override {
+    if (event->type() == QEvent::Paint)
+      ++paints;
+    return false;
+  }
+};
+
+// QTest has no wheel events and its mouse moves do not carry the held buttons, those events are sent directly.
+void send(NetworkEditorView &view, const interaction_trace::Event &event) {
+  QWidget *viewport = view.viewport();
+  const QPoint pos = view.mapFromScene(event.pos);
+  const auto button = static_cast<Qt::MouseButton>(event.button);
+  const auto buttons = static_cast<Qt::MouseButtons>(event.buttons);
+  const auto modifiers = static_cast<Qt::KeyboardModifiers>(event.modifiers);
+  switch (event.type) {
+    case QEvent::MouseButtonPress:
+      QTest::mousePress(viewport, button, modifiers, pos);
+      break;
+    case QEvent::MouseButtonRelease:
+      QTest::mouseRelease(viewport, button, modifiers, pos);
+      break;
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove: {
+      QMouseEvent mouse_event(event.type, pos, viewport->mapToGlobal(pos), button, buttons, modifiers);
+      QApplication::sendEvent(viewport, &mouse_event);
+      break;
+    }
+    case QEvent::Wheel: {
+      QWheelEvent wheel_event(pos, viewport->mapToGlobal(pos), QPoint(), event.angle_delta, buttons, modifiers,
+                              Qt::NoScrollPhase, false);
+      QApplication::sendEvent(viewport, &wheel_event);
+      break;
+    }
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+      QTest::sendKeyEvent(event.type == QEvent::KeyPress ? QTest::Press : QTest::Release, &view,
+                          static_cast<Qt::Key>(event.key), event.text, modifiers);
+      break;
+    default:
+      break;
+  }
+}
+
+// The recorder stores the size of the viewport. Scroll bars are turned off, so that the viewport keeps that size
+// whatever the extent of the scene, and the view is resized by the frame around the viewport.
+void resize_viewport(NetworkEditorView &view, const QSize &size) {
+  view.resize(size + view.size() - view.viewport()->size());
+}
+
+}
+
+int main(int argc, char *argv[]) {
+  using namespace ParaViewNetworkEditor;
+
+  headless::use_offscreen_platform();
+  QApplication app(argc, argv);
+  QApplication::setApplicationName("pvnetworkreplay");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Replays a network editor interaction trace on a state file.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("state", "State file (.pvsm) the trace was recorded on.");
+  parser.addPositionalArgument("trace", "Interaction trace (.json).");
+  QCommandLineOption realtime_option("realtime", "Keep the recorded time between events.");
+  QCommandLineOption repeat_option("repeat", "Number of replays, the state is loaded again for each (default 1).",
+                                   "n", "1");
+  QCommandLineOption output_option(QStringList{"o", "output"}, "JSON file of the results, default stdout.", "file");
+  QCommandLineOption plugin_option("plugin", "Network editor plugin that provides the proxy definitions.", "file",
+                                   NETWORKEDITOR_PLUGIN_FILE);
+  parser.addOptions({realtime_option, repeat_option, output_option, plugin_option});
+  parser.process(app);
+
+  const QStringList arguments = parser.positionalArguments();
+  if (arguments.size() != 2) {
+    parser.showHelp(1);
+  }
+  const QString state = arguments[0];
+  const int repeat = parser.value(repeat_option).toInt();
+  if (!QFileInfo(state).isFile() || repeat < 1) {
+    std::cerr << "Invalid state file or number of replays" << std::endl;
+    return 1;
+  }
+  interaction_trace::Trace trace;
+  if (!interaction_trace::load(arguments[1], trace)) {
+    std::cerr << "Could not read interaction trace " << arguments[1].toStdString() << std::endl;
+    return 1;
+  }
+
+  // ParaView must not see the arguments of this tool
+  int core_argc = 1;
+  pqPVApplicationCore core(core_argc, argv);
+  pqServer *server = headless::start_session(core, parser.value(plugin_option));
+  if (!server) {
+    return 1;
+  }
+  // undo sets are recorded like in the GUI
+  core.setUndoStack(new pqUndoStack(false, nullptr, &core));
+
+  NetworkEditor editor;
+  NetworkEditorView view(&editor);
+  view.setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  view.setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+  view.show();
+  resize_viewport(view, trace.view_size);
+  PaintCounter counter;
+  view.viewport()->installEventFilter(&counter);
+
+  std::vector<double> latencies, frames, replays;
+  std::map<QEvent::Type, std::vector<double>> latencies_by_type;
+  for (int i = 0; i < repeat; ++i) {
+    if (i > 0) {
+      vtkNew<vtkSMParaViewPipelineController> controller;
+      controller->ResetSession(server->session());
+    }
+    core.loadState(state.toUtf8().constData(), server);
+    core.getUndoStack()->clear();
+    resize_viewport(view, trace.view_size);
+    view.setTransform(trace.transform);
+    view.centerOn(trace.center);
+    QApplication::processEvents();
+
+    QElapsedTimer replay_timer;
+    replay_timer.start();
+    for (const interaction_trace::Event &event : trace.events) {
+      if (parser.isSet(realtime_option)) {
+        const qint64 wait = static_cast<qint64>(event.time) - replay_timer.elapsed();
+        if (wait > 0)
+          QTest::qWait(static_cast<int>(wait));
+      }
+      auto start = std::chrono::steady_clock::now();
+      send(view, event);
+      auto sent = std::chrono::steady_clock::now();
+      const int paints = counter.paints;
+      QApplication::processEvents();
+      auto end = std::chrono::steady_clock::now();
+
+      const double latency = std::chrono::duration<double, std::milli>(sent - start).count();
+      latencies.push_back(latency);
+      latencies_by_type[event.type].push_back(latency);
+      if (counter.paints != paints)
+        frames.push_back(std::chrono::duration<double, std::milli>(end - sent).count());
+    }
+    replays.push_back(replay_timer.nsecsElapsed() * 1e-6);
+  }
+
+  QJsonObject by_type;
+  for (const auto &kv : latencies_by_type) {
+    by_type[interaction_trace::type_name(kv.first)] = histogram(kv.second);
+  }
+
+  QJsonObject root;
+  root["state"] = state;
+  root["trace"] = arguments[1];
+  root["events"] = static_cast<int>(trace.events.size());
+  root["repeat"] = repeat;
+  root["realtime"] = parser.isSet(realtime_option);
+  root["replay"] = histogram(replays);
+  root["event_latency"] = histogram(latencies);
+  root["event_latency_by_type"] = by_type;
+  root["frame_time"] = histogram(frames);
+  const QByteArray json = QJsonDocument(root).toJson();
+
+  if (!parser.isSet(output_option)) {
+    std::cout << json.constData();
+    return 0;
+  }
+  QFile file(parser.value(output_option));
+  if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()) {
+    std::cerr << "Could not write " << file.fileName().toStdString() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,210 @@
+#include "node_layout.h"
+
+#include <vtkNew.h>
+#include <vtkPVXMLElement.h>
+#include <vtkSMProxy.h>
+#include <vtkSMSession.h>
+#include <vtkSMProxyLocator.h>
+#include <vtkSMPropertyHelper.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+namespace node_layout {
+
+namespace {
+
+struct NodeGeometry {
+  double x = 0., y = 0., width = 0., height = 0.;
+  bool has_position = false;
+  bool has_size = false;
+};
+
+std::unordered_map<vtkTypeUInt32, NodeGeometry> &table() {
+  static std::unordered_map<vtkTypeUInt32, NodeGeometry> nodes;
+  return nodes;
+}
+
+const int record_size = 5;
+
+// Sets an annotation in the saved XML state of a proxy, replacing the one the proxy was saved with, if any.
+void set_annotation(vtkPVXMLElement *element, const char *key, double value) {
+  const std::string text = std::to_string(value);
+  for (unsigned int i = 0; i < element->GetNumberOfNestedElements(); ++i) {
+    vtkPVXMLElement *child = element->GetNestedElement(i);
+    if (std::strcmp(child->GetName(), "Annotation") == 0 && child->GetAttribute("key")
+        && std::strcmp(child->GetAttribute("key"), key) == 0) {
+      child->SetAttribute("value", text.c_str());
+      return;
+    }
+  }
+  vtkNew<vtkPVXMLElement> annotation;
+  annotation->SetName("Annotation");
+  annotation->AddAttribute("key", key);
+  annotation->AddAttribute("value", text.c_str());
+  element->AddNestedElement(annotation);
+}
+
+}
+
+bool get_position(vtkSMProxy *proxy, QPointF &pos) {
+  if (!proxy)
+    return false;
+  auto it = table().find(proxy->GetGlobalID());
+  if (it != table().end() && it->second.has_position) {
+    pos = QPointF(it->second.x, it->second.y);
+    return true;
+  }
+  if (!proxy->HasAnnotation("Node.x") || !proxy->HasAnnotation("Node.y"))
+    return false;
+  pos = QPointF(std::atof(proxy->GetAnnotation("Node.x")), std::atof(proxy->GetAnnotation("Node.y")));
+  set_position(proxy, pos);
+  return true;
+}
+
+void set_position(vtkSMProxy *proxy, const QPointF &pos) {
+  if (!proxy)
+    return;
+  NodeGeometry &node = table()[proxy->GetGlobalID()];
+  node.x = pos.x();
+  node.y = pos.y();
+  node.has_position = true;
+}
+
+bool get_size(vtkSMProxy *proxy, QSizeF &size) {
+  if (!proxy)
+    return false;
+  auto it = table().find(proxy->GetGlobalID());
+  if (it != table().end() && it->second.has_size) {
+    size = QSizeF(it->second.width, it->second.height);
+    return true;
+  }
+  if (!proxy->HasAnnotation("Node.width") || !proxy->HasAnnotation("Node.height"))
+    return false;
+  size = QSizeF(std::atof(proxy->GetAnnotation("Node.width")), std::atof(proxy->GetAnnotation("Node.height")));
+  set_size(proxy, size);
+  return true;
+}
+
+void set_size(vtkSMProxy *proxy, const QSizeF &size) {
+  if (!proxy)
+    return;
+  NodeGeometry &node = table()[proxy->GetGlobalID()];
+  node.width = size.width();
+  node.height = size.height();
+  node.has_size = true;
+}
+
+bool move(vtkTypeUInt32 id, const QPointF &offset, const QSizeF &resize) {
+  auto it = table().find(id);
+  if (it == table().end())
+    return false;
+  NodeGeometry &node = it->second;
+  if (node.has_position) {
+    node.x += offset.x();
+    node.y += offset.y();
+  }
+  if (node.has_size) {
+    node.width += resize.width();
+    node.height += resize.height();
+  }
+  return true;
+}
+
+void write_annotations(vtkSMProxy *proxy, vtkPVXMLElement *element) {
+  if (!proxy || !element)
+    return;
+  auto it = table().find(proxy->GetGlobalID());
+  if (it == table().end())
+    return;
+  const NodeGeometry &node = it->second;
+  if (node.has_position) {
+    set_annotation(element, "Node.x", node.x);
+    set_annotation(element, "Node.y", node.y);
+  }
+  if (node.has_size) {
+    set_annotation(element, "Node.width", node.width);
+    set_annotation(element, "Node.height", node.height);
+  }
+}
+
+void save(vtkSMProxy *settings) {
+  if (!settings)
+    return;
+  vtkSMSession *session = settings->GetSession();
+  std::vector<double> values;
+  values.reserve(table().size() * record_size);
+  for (const auto &kv : table()) {
+    const NodeGeometry &node = kv.second;
+    if (!node.has_position)
+      continue;
+    // entries of deleted proxies are kept in the table so that undoing the deletion restores them
+    if (session && !session->GetRemoteObject(kv.first))
+      continue;
+    values.push_back(kv.first);
+    values.push_back(node.x);
+    values.push_back(node.y);
+    values.push_back(node.has_size ? node.width : 0.);
+    values.push_back(node.has_size ? node.height : 0.);
+  }
+  vtkSMPropertyHelper helper(settings, "NodeLayout");
+  if (values.empty()) {
+    helper.SetNumberOfElements(0);
+  } else {
+    helper.Set(values.data(), static_cast<unsigned int>(values.size()));
+  }
+}
+
+void load(vtkSMProxy *settings, vtkSMProxyLocator *locator) {
+  if (!settings)
+    return;
+  std::vector<double> values = vtkSMPropertyHelper(settings, "NodeLayout").GetDoubleArray();
+  vtkSMSession *session = settings->GetSession();
+  for (size_t i = 0; i + record_size <= values.size(); i += record_size) {
+    auto id = static_cast<vtkTypeUInt32>(values[i]);
+    vtkSMProxy *proxy = nullptr;
+    if (locator) {
+      proxy = locator->LocateProxy(id);
+    } else if (session) {
+      proxy = vtkSMProxy::SafeDownCast(session->GetRemoteObject(id));
+    }
+    if (!proxy)
+      continue;
+    NodeGeometry &node = table()[proxy->GetGlobalID()];
+    node.x = values[i + 1];
+    node.y = values[i + 2];
+    node.has_position = true;
+    if (values[i + 3] > 0. && values[i + 4] > 0.) {
+      node.width = values[i + 3];
+      node.height = values[i + 4];
+      node.has_size = true;
+    }
+  }
+}
+
+void erase(vtkTypeUInt32 id) {
+  table().erase(id);
+}
+
+void prune(vtkSMSession *session) {
+  if (!session)
+    return;
+  for (auto it = table().begin(); it != table().end();) {
+    if (session->GetRemoteObject(it->first)) {
+      ++it;
+    } else {
+      it = table().erase(it);
+    }
+  }
+}
+
+void clear() {
+  table().clear();
+}
+
+}
+}
@@ -0,0 +1,52 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_NODE_LAYOUT_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_NODE_LAYOUT_H_
+
+#include <vtkType.h>
+#include <QPointF>
+#include <QSizeF>
+
+class vtkPVXMLElement;
+class vtkSMProxy;
+class vtkSMProxyLocator;
+class vtkSMSession;
+
+namespace ParaViewNetworkEditor {
+namespace node_layout {
+
+// Node geometry is kept in a table keyed by proxy global id and saved once per state as the packed
+// "NodeLayout" property of the NetworkEditorViewSettings proxy, (id, x, y, width, height) per node.
+// The Node.x/Node.y/Node.width/Node.height annotations of states and clipboards written by older
+// versions are still read when a proxy has no entry in the table.
+
+bool get_position(vtkSMProxy *proxy, QPointF &pos);
+
+void set_position(vtkSMProxy *proxy, const QPointF &pos);
+
+bool get_size(vtkSMProxy *proxy, QSizeF &size);
+
+void set_size(vtkSMProxy *proxy, const QSizeF &size);
+
+// Shifts the stored geometry of a node. Returns false if the node has no entry.
+bool move(vtkTypeUInt32 id, const QPointF &offset, const QSizeF &resize);
+
+// Writes the stored geometry as annotations into the saved XML state of the proxy, used when the proxy state
+// leaves the session (e.g. copy). The proxy itself keeps its annotations.
+void write_annotations(vtkSMProxy *proxy, vtkPVXMLElement *element);
+
+// Stores the table entries of proxies that still exist in the settings proxy.
+void save(vtkSMProxy *settings);
+
+// Reads the table from a loaded settings proxy, mapping the ids of the state file with the locator.
+void load(vtkSMProxy *settings, vtkSMProxyLocator *locator);
+
+// Entries of deleted proxies are kept so that undoing the deletion restores their geometry. erase drops the entry
+// of a proxy that cannot come back, prune those of all proxies missing from the session.
+void erase(vtkTypeUInt32 id);
+void prune(vtkSMSession *session);
+
+void clear();
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_NODE_LAYOUT_H_
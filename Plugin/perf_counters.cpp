@@ -0,0 +1,40 @@
+#include "perf_counters.h"
+
+namespace ParaViewNetworkEditor {
+namespace perf_counters {
+
+namespace detail {
+std::array<std::atomic<std::uint64_t>, NUM_COUNTERS> counters{};
+}
+
+Snapshot snapshot() {
+  Snapshot result;
+  for (int i = 0; i < NUM_COUNTERS; ++i) {
+    result[i] = detail::counters[i].load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+Snapshot difference(const Snapshot &after, const Snapshot &before) {
+  Snapshot result;
+  for (int i = 0; i < NUM_COUNTERS; ++i) {
+    result[i] = after[i] - before[i];
+  }
+  return result;
+}
+
+const char *label(Counter counter) {
+  switch (counter) {
+    case ITEMS_PAINTED: return "Items painted";
+    case VISIBILITY_QUERIES: return "Visibility queries";
+    case DATA_INFORMATION_QUERIES: return "Data information queries";
+    case DOMAIN_CHECKS: return "Domain checks";
+    case SELECTION_SYNCS_TO_PARAVIEW: return "Selection syncs to ParaView";
+    case SELECTION_SYNCS_FROM_PARAVIEW: return "Selection syncs from ParaView";
+    case NUM_COUNTERS: break;
+  }
+  return "";
+}
+
+}
+}
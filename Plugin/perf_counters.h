@@ -0,0 +1,44 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_PERF_COUNTERS_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_PERF_COUNTERS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ParaViewNetworkEditor {
+namespace perf_counters {
+
+// Event counters of the editor's hot paths, shown per frame in the performance HUD. They are always counted:
+// an increment is a single relaxed atomic add, so slowness can be diagnosed in production without a profiler.
+enum Counter {
+  ITEMS_PAINTED,
+  VISIBILITY_QUERIES,
+  DATA_INFORMATION_QUERIES,
+  DOMAIN_CHECKS,
+  SELECTION_SYNCS_TO_PARAVIEW,
+  SELECTION_SYNCS_FROM_PARAVIEW,
+  NUM_COUNTERS
+};
+
+using Snapshot = std::array<std::uint64_t, NUM_COUNTERS>;
+
+namespace detail {
+extern std::array<std::atomic<std::uint64_t>, NUM_COUNTERS> counters;
+}
+
+inline void increment(Counter counter, std::uint64_t n = 1) {
+  detail::counters[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+// Totals since startup.
+Snapshot snapshot();
+
+// Element-wise after - before, for the counts of a frame.
+Snapshot difference(const Snapshot &after, const Snapshot &before);
+
+const char *label(Counter counter);
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_PERF_COUNTERS_H_
@@ -0,0 +1,123 @@
+#include "pipeline_analysis.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace ParaViewNetworkEditor {
+namespace pipeline_analysis {
+
+std::vector<size_t> topological_order(const Graph &graph) {
+  std::vector<size_t> in_degree(graph.num_nodes, 0);
+  std::vector<std::vector<size_t>> consumers(graph.num_nodes);
+  for (const auto &edge : graph.edges) {
+    consumers[edge.first].push_back(edge.second);
+    ++in_degree[edge.second];
+  }
+
+  std::vector<size_t> order;
+  order.reserve(graph.num_nodes);
+  for (size_t node = 0; node < graph.num_nodes; ++node) {
+    if (in_degree[node] == 0)
+      order.push_back(node);
+  }
+  // order doubles as the queue of Kahn's algorithm
+  for (size_t i = 0; i < order.size(); ++i) {
+    for (size_t consumer : consumers[order[i]]) {
+      if (--in_degree[consumer] == 0)
+        order.push_back(consumer);
+    }
+  }
+  return order;
+}
+
+std::vector<CriticalPath> critical_paths(const Graph &graph, const std::vector<double> &weights,
+                                         const std::vector<size_t> &sinks) {
+  const size_t none = std::numeric_limits<size_t>::max();
+  std::vector<std::vector<size_t>> producers(graph.num_nodes);
+  for (const auto &edge : graph.edges) {
+    producers[edge.second].push_back(edge.first);
+  }
+
+  // cost[n] is the most expensive path ending in n, predecessor[n] the previous node on it
+  std::vector<double> cost(graph.num_nodes, 0.);
+  std::vector<size_t> predecessor(graph.num_nodes, none);
+  for (size_t node : topological_order(graph)) {
+    double max = 0.;
+    for (size_t producer : producers[node]) {
+      if (predecessor[node] == none || cost[producer] > max) {
+        max = cost[producer];
+        predecessor[node] = producer;
+      }
+    }
+    cost[node] = max + weights[node];
+  }
+
+  std::vector<CriticalPath> paths;
+  paths.reserve(sinks.size());
+  for (size_t sink : sinks) {
+    CriticalPath path;
+    path.sink = sink;
+    path.cost = cost[sink];
+    for (size_t node = sink; node != none; node = predecessor[node]) {
+      path.nodes.push_back(node);
+    }
+    std::reverse(path.nodes.begin(), path.nodes.end());
+    paths.push_back(std::move(path));
+  }
+  std::sort(paths.begin(), paths.end(), [](const CriticalPath &a, const CriticalPath &b) {
+    return a.cost > b.cost;
+  });
+  return paths;
+}
+
+std::vector<bool> upstream_nodes(const Graph &graph, const std::vector<bool> &roots) {
+  std::vector<std::vector<size_t>> producers(graph.num_nodes);
+  for (const auto &edge : graph.edges) {
+    producers[edge.second].push_back(edge.first);
+  }
+
+  // walk upstream from the roots, each node is visited once
+  std::vector<bool> upstream(graph.num_nodes, false);
+  std::vector<size_t> stack;
+  for (size_t node = 0; node < graph.num_nodes; ++node) {
+    if (roots[node]) {
+      upstream[node] = true;
+      stack.push_back(node);
+    }
+  }
+  while (!stack.empty()) {
+    size_t node = stack.back();
+    stack.pop_back();
+    for (size_t producer : producers[node]) {
+      if (!upstream[producer]) {
+        upstream[producer] = true;
+        stack.push_back(producer);
+      }
+    }
+  }
+  return upstream;
+}
+
+std::vector<bool> dead_nodes(const Graph &graph, const std::vector<bool> &live) {
+  std::vector<bool> dead = upstream_nodes(graph, live);
+  dead.flip();
+  return dead;
+}
+
+std::vector<size_t> equivalent_nodes(const Graph &graph, const SignatureFunction &signature) {
+  std::vector<size_t> groups(graph.num_nodes);
+  for (size_t node = 0; node < graph.num_nodes; ++node) {
+    groups[node] = node;
+  }
+  std::unordered_map<std::string, size_t> representatives;
+  representatives.reserve(graph.num_nodes);
+  for (size_t node : topological_order(graph)) {
+    auto result = representatives.emplace(signature(node, groups), node);
+    groups[node] = result.first->second;
+  }
+  return groups;
+}
+
+}
+}
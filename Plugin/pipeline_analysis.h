@@ -0,0 +1,51 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINE_ANALYSIS_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINE_ANALYSIS_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+namespace pipeline_analysis {
+
+// The pipeline as a directed graph with nodes 0..num_nodes-1 and edges from producer to consumer.
+// All analyses run in time linear in the number of nodes plus edges.
+struct Graph {
+  size_t num_nodes = 0;
+  std::vector<std::pair<size_t, size_t>> edges;
+};
+
+// Nodes sorted so that producers come before their consumers. Nodes on cycles are left out.
+std::vector<size_t> topological_order(const Graph &graph);
+
+struct CriticalPath {
+  size_t sink = 0;
+  // sum of the weights of the nodes on the path
+  double cost = 0.;
+  // from the first producer to the sink
+  std::vector<size_t> nodes;
+};
+
+// The path with the largest sum of node weights that ends in each of the sinks.
+std::vector<CriticalPath> critical_paths(const Graph &graph, const std::vector<double> &weights,
+                                         const std::vector<size_t> &sinks);
+
+// The roots and all nodes that feed them, directly or through other nodes.
+std::vector<bool> upstream_nodes(const Graph &graph, const std::vector<bool> &roots);
+
+// Nodes that are not live and do not feed a live node, directly or through other nodes.
+std::vector<bool> dead_nodes(const Graph &graph, const std::vector<bool> &live);
+
+// Groups nodes with equal signatures. Nodes are visited producers first, and the signature function gets the
+// groups found so far, so that a signature can refer to the groups of the producers instead of the producers
+// themselves. Thereby identical sub-pipelines are found as a whole. Returns the group of each node, which is the
+// first visited node with the same signature.
+using SignatureFunction = std::function<std::string(size_t node, const std::vector<size_t> &groups)>;
+std::vector<size_t> equivalent_nodes(const Graph &graph, const SignatureFunction &signature);
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINE_ANALYSIS_H_
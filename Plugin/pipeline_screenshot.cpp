@@ -0,0 +1,267 @@
+#include "pipeline_screenshot.h"
+#include "NetworkEditor.h"
+
+#include <vtkLogger.h>
+#ifdef VTK_HAS_PNG
+# include <vtk_png.h>
+#endif
+
+#include <QFile>
+#include <QFileInfo>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+#ifdef QT_HAS_SVG
+# include <QSvgGenerator>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+namespace pipeline_screenshot {
+
+namespace {
+
+const int tile_size = 1024;
+
+#ifdef VTK_HAS_PNG
+// Minimal streaming PNG encoder on top of libpng. Every call that may fail sets its own error return point,
+// as libpng reports errors with longjmp.
+class PngWriter {
+ public:
+  PngWriter() = default;
+  ~PngWriter() {
+    if (png_)
+      png_destroy_write_struct(&png_, info_ ? &info_ : nullptr);
+    if (file_)
+      std::fclose(file_);
+  }
+  PngWriter(const PngWriter &) = delete;
+  PngWriter &operator=(const PngWriter &) = delete;
+
+  bool open(const QString &path, const QSize &size) {
+    file_ = std::fopen(QFile::encodeName(path).constData(), "wb");
+    if (!file_)
+      return false;
+    png_ = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if (!png_)
+      return false;
+    info_ = png_create_info_struct(png_);
+    if (!info_)
+      return false;
+    if (setjmp(png_jmpbuf(png_)))
+      return false;
+    png_init_io(png_, file_);
+    png_set_IHDR(png_, info_, static_cast<png_uint_32>(size.width()), static_cast<png_uint_32>(size.height()), 8,
+                 PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png_, info_);
+    return true;
+  }
+
+  // RGBA, 8 bit per channel, not premultiplied
+  bool writeRow(const uchar *row) {
+    if (setjmp(png_jmpbuf(png_)))
+      return false;
+    png_write_row(png_, const_cast<png_bytep>(row));
+    return true;
+  }
+
+  bool finish() {
+    if (setjmp(png_jmpbuf(png_)))
+      return false;
+    png_write_end(png_, nullptr);
+    return std::fflush(file_) == 0;
+  }
+
+ private:
+  FILE *file_ = nullptr;
+  png_structp png_ = nullptr;
+  png_infop info_ = nullptr;
+};
+#else
+// Without libpng the rows are collected in a single image, which Qt encodes at the end.
+class PngWriter {
+ public:
+  bool open(const QString &path, const QSize &size) {
+    path_ = path;
+    image_ = QImage(size, QImage::Format_RGBA8888);
+    return !image_.isNull();
+  }
+  bool writeRow(const uchar *row) {
+    std::memcpy(image_.scanLine(row_++), row, static_cast<size_t>(image_.width()) * 4);
+    return true;
+  }
+  bool finish() {
+    return image_.save(path_, "PNG");
+  }
+ private:
+  QString path_;
+  QImage image_;
+  int row_ = 0;
+};
+#endif
+
+class TileJob : public QRunnable {
+ public:
+  TileJob(const QByteArray &picture, QImage *tile, const QPoint &offset, QSemaphore *done)
+      : picture_(picture), tile_(tile), offset_(offset), done_(done) {}
+
+  void run() override {
+    // copies of a QPicture share the buffer that play() reads from, so each job replays its own picture
+    QPicture picture;
+    picture.setData(picture_.constData(), static_cast<uint>(picture_.size()));
+    tile_->fill(Qt::transparent);
+    {
+      QPainter painter(tile_);
+      painter.translate(-offset_);
+      picture.play(&painter);
+    }
+    *tile_ = tile_->convertToFormat(QImage::Format_RGBA8888);
+    done_->release();
+  }
+
+ private:
+  QByteArray picture_;
+  QImage *tile_;
+  QPoint offset_;
+  QSemaphore *done_;
+};
+
+// A row of tiles
+struct Band {
+  int top = 0;
+  int height = 0;
+  std::vector<QImage> tiles;
+  QSemaphore done;
+};
+
+void start_band(Band &band, const QByteArray &picture, const QSize &size, int top) {
+  band.top = top;
+  band.height = std::min(tile_size, size.height() - top);
+  band.tiles.clear();
+  // the jobs keep pointers to the tiles
+  band.tiles.reserve(static_cast<size_t>((size.width() + tile_size - 1) / tile_size));
+  for (int left = 0; left < size.width(); left += tile_size) {
+    band.tiles.emplace_back(std::min(tile_size, size.width() - left), band.height, QImage::Format_ARGB32_Premultiplied);
+    QThreadPool::globalInstance()->start(new TileJob(picture, &band.tiles.back(), QPoint(left, top), &band.done));
+  }
+}
+
+std::atomic<unsigned int> temporary_counter{0};
+
+}
+
+QPicture record(QGraphicsScene *scene, const QRectF &target, const QRectF &source) {
+  vtkLogScopeF(8, "pipeline_screenshot::record");
+  QPicture picture;
+  QPainter painter(&picture);
+  scene->render(&painter, target, source);
+  painter.end();
+  return picture;
+}
+
+QPicture record(NetworkEditor *editor, double scale, bool transparent, QSize *size) {
+  const QRectF source = editor->getSourcesBoundingRect().adjusted(-50, -50, 50, 50);
+  const QRectF target(QPointF(0, 0), source.size() * scale);
+  editor->setBackgroundTransparent(transparent);
+  QPicture picture = record(editor, target, source);
+  editor->setBackgroundTransparent(false);
+  if (size)
+    *size = target.size().toSize();
+  return picture;
+}
+
+bool write_png(const QPicture &picture, const QSize &size, const QString &path, const std::atomic<bool> *cancel) {
+  vtkLogScopeF(8, "pipeline_screenshot::write_png");
+  if (size.isEmpty())
+    return false;
+  const QByteArray data(picture.data(), static_cast<int>(picture.size()));
+  const QString temporary_path = QString("%1.%2.tmp").arg(path).arg(temporary_counter++);
+
+  bool ok = true;
+  {
+    PngWriter writer;
+    ok = writer.open(temporary_path, size);
+    std::vector<uchar> row(static_cast<size_t>(size.width()) * 4);
+
+    // one band is written while the next one is rasterized
+    Band bands[2];
+    int current = 0;
+    if (ok)
+      start_band(bands[current], data, size, 0);
+    for (int top = 0; ok && top < size.height(); top += tile_size) {
+      Band &band = bands[current];
+      const bool cancelled = cancel && cancel->load();
+      if (!cancelled && top + tile_size < size.height())
+        start_band(bands[current ^ 1], data, size, top + tile_size);
+      band.done.acquire(static_cast<int>(band.tiles.size()));
+      if (cancelled) {
+        ok = false;
+        break;
+      }
+      for (int y = 0; ok && y < band.height; ++y) {
+        uchar *dst = row.data();
+        for (const QImage &tile : band.tiles) {
+          const size_t bytes = static_cast<size_t>(tile.width()) * 4;
+          std::memcpy(dst, tile.constScanLine(y), bytes);
+          dst += bytes;
+        }
+        ok = writer.writeRow(row.data());
+      }
+      band.tiles.clear();
+      current ^= 1;
+      if (!ok && top + tile_size < size.height()) {
+        // wait for the band that is already being rasterized, it references this stack frame
+        bands[current].done.acquire(static_cast<int>(bands[current].tiles.size()));
+      }
+    }
+    ok = ok && writer.finish();
+  }
+
+  // a job that was cancelled while encoding the last rows must not replace the file of the newer job
+  if (!ok || (cancel && cancel->load())) {
+    QFile::remove(temporary_path);
+    return false;
+  }
+  QFile::remove(path);
+  return QFile::rename(temporary_path, path);
+}
+
+bool save(NetworkEditor *editor, const QString &path, double scale, bool transparent) {
+  vtkLogScopeF(8, "pipeline_screenshot::save");
+  if (QFileInfo(path).suffix().toLower() != "svg") {
+    // large networks do not fit into a single image, the screenshot is rasterized in tiles
+    QSize size;
+    QPicture picture = record(editor, scale, transparent, &size);
+    return write_png(picture, size, path);
+  }
+#ifdef QT_HAS_SVG
+  const QRectF source = editor->getSourcesBoundingRect().adjusted(-50, -50, 50, 50);
+  const QRectF target(QPointF(0, 0), source.size() * scale);
+  QSvgGenerator generator;
+  generator.setFileName(path);
+  generator.setSize(target.size().toSize());
+  generator.setViewBox(target);
+  generator.setDescription("");
+  generator.setTitle("");
+  QPainter painter;
+  if (!painter.begin(&generator))
+    return false;
+  editor->setBackgroundTransparent(transparent);
+  editor->render(&painter, target, source);
+  editor->setBackgroundTransparent(false);
+  return painter.end();
+#else
+  vtkLog(ERROR, "Qt SVG support not available.");
+  return false;
+#endif
+}
+
+}
+}
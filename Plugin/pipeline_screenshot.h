@@ -0,0 +1,38 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINE_SCREENSHOT_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINE_SCREENSHOT_H_
+
+#include <QPicture>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+
+#include <atomic>
+
+class QGraphicsScene;
+
+namespace ParaViewNetworkEditor {
+
+class NetworkEditor;
+
+namespace pipeline_screenshot {
+
+// Records the source rect of the scene, scaled to the target rect, into a display list. Recording is fast and
+// has to happen in the GUI thread; the display list can then be rasterized in other threads.
+QPicture record(QGraphicsScene *scene, const QRectF &target, const QRectF &source);
+
+// Records all sources of the editor with a margin, scaled by scale. The size of the image is returned in size.
+QPicture record(NetworkEditor *editor, double scale, bool transparent, QSize *size);
+
+// Rasterizes the display list in tiles on the global thread pool and streams the rows into a PNG file, so
+// that only two bands of tiles are in memory at any time. The file is written under a temporary name and
+// only replaces the path when complete. Returns false if writing failed or was cancelled.
+bool write_png(const QPicture &picture, const QSize &size, const QString &path,
+               const std::atomic<bool> *cancel = nullptr);
+
+// Saves a screenshot of all sources, as SVG if the path has an .svg suffix and as PNG otherwise.
+bool save(NetworkEditor *editor, const QString &path, double scale, bool transparent);
+
+}
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_PIPELINE_SCREENSHOT_H_
@@ -1,14 +1,19 @@
 #include "utilpq.h"
+#include "DataInformationCache.h"
+#include "perf_counters.h"
 
 #include <vtkSMProxy.h>
 #include <vtkSMProperty.h>
 #include <vtkSMInputProperty.h>
 #include <vtkSMPropertyHelper.h>
+#include <vtkSMDoubleVectorProperty.h>
+#include <vtkSMIdTypeVectorProperty.h>
+#include <vtkSMIntVectorProperty.h>
+#include <vtkSMStringVectorProperty.h>
 #include <vtkPVXMLElement.h>
 #include <vtkSMPropertyIterator.h>
 #include <vtkSMProxyManager.h>
 #include <vtkSMSessionProxyManager.h>
-#include <vtkSMProxyIterator.h>
 #include <vtkSMSourceProxy.h>
 #include <vtkSMParaViewPipelineControllerWithRendering.h>
 #include <vtkSMPVRepresentationProxy.h>
@@ -27,9 +32,13 @@
 #include <pqApplicationCore.h>
 #include <pqServerManagerModel.h>
 #include <pqActiveObjects.h>
+#include <pqDataRepresentation.h>
+#include <pqView.h>
 #include <vtkPVConfig.h>
 #include <pqObjectBuilder.h>
 
+#include <QPointer>
+
 #include <set>
 
 namespace ParaViewNetworkEditor {
@@ -37,6 +46,43 @@ namespace utilpq {
 
 static vtkSMParaViewPipelineControllerWithRendering *controller = vtkSMParaViewPipelineControllerWithRendering::New();
 
+static int transaction_depth = 0;
+static std::vector<QPointer<pqPipelineFilter>> transaction_filters;
+
+static void transaction_modified(pqPipelineFilter *filter) {
+  for (const auto &modified : transaction_filters) {
+    if (modified == filter)
+      return;
+  }
+  transaction_filters.emplace_back(filter);
+}
+
+static void transaction_update() {
+  std::vector<QPointer<pqPipelineFilter>> filters;
+  filters.swap(transaction_filters);
+  for (const auto &filter : filters) {
+    if (filter)
+      filter->getProxy()->UpdateVTKObjects();
+  }
+}
+
+ConnectionTransaction::ConnectionTransaction() {
+  ++transaction_depth;
+}
+
+ConnectionTransaction::~ConnectionTransaction() {
+  if (transaction_depth > 1) {
+    --transaction_depth;
+    return;
+  }
+  transaction_update();
+  // connections to the dummy source removed here are part of this transaction
+  collect_dummy_source();
+  transaction_update();
+  --transaction_depth;
+  pqApplicationCore::instance()->render();
+}
+
 bool multiple_inputs(pqPipelineFilter *filter, int port) {
   QString input_name = filter->getInputPortName(port);
   vtkSMInputProperty *ip = vtkSMInputProperty::SafeDownCast(
@@ -71,6 +117,7 @@ bool can_connect(pqPipelineSource *source, int out_port, pqPipelineFilter *dest,
 
   input->RemoveAllUncheckedProxies();
   input->AddUncheckedInputConnection(source->getProxy(), out_port);
+  perf_counters::increment(perf_counters::DOMAIN_CHECKS);
   bool result = input->IsInDomains() > 0;
   input->RemoveAllUncheckedProxies();
 
@@ -101,6 +148,7 @@ bool can_connect(pqPipelineSource *source, int out_port, const char* groupname,
 
   input_property->RemoveAllUncheckedProxies();
   input_property->AddUncheckedInputConnection(source->getProxy(), out_port);
+  perf_counters::increment(perf_counters::DOMAIN_CHECKS);
   bool result = input_property->IsInDomains() > 0;
   input_property->RemoveAllUncheckedProxies();
 
@@ -108,6 +156,7 @@ bool can_connect(pqPipelineSource *source, int out_port, const char* groupname,
 }
 
 void add_connection(pqPipelineSource *source, int out_port, pqPipelineFilter *dest, int in_port) {
+  ConnectionTransaction transaction;
   QString input_name = dest->getInputPortName(in_port);
   std::vector<vtkSMProxy *> inputPtrs;
   std::vector<unsigned int> inputPorts;
@@ -126,14 +175,11 @@ void add_connection(pqPipelineSource *source, int out_port, pqPipelineFilter *de
   inputPorts.push_back(out_port);
 
   ip->SetProxies(static_cast<unsigned int>(inputPtrs.size()), &inputPtrs[0], &inputPorts[0]);
-
-  collect_dummy_source();
-
-  dest->getProxy()->UpdateVTKObjects();
-  pqApplicationCore::instance()->render();
+  transaction_modified(dest);
 }
 
 void remove_connection(pqPipelineSource *source, int out_port, pqPipelineFilter *dest, int in_port) {
+  ConnectionTransaction transaction;
   QString input_name = dest->getInputPortName(in_port);
   std::vector<vtkSMProxy *> inputPtrs;
   std::vector<unsigned int> inputPorts;
@@ -160,54 +206,99 @@ void remove_connection(pqPipelineSource *source, int out_port, pqPipelineFilter
   vtkSMInputProperty *ip = vtkSMInputProperty::SafeDownCast(
       dest->getProxy()->GetProperty(input_name.toLocal8Bit().data()));
   ip->SetProxies(static_cast<unsigned int>(inputPtrs.size()), &inputPtrs[0], &inputPorts[0]);
+  transaction_modified(dest);
+}
 
-  dest->getProxy()->UpdateVTKObjects();
-  pqApplicationCore::instance()->render();
+void replace_input(pqPipelineFilter *dest, pqPipelineSource *old_source, pqPipelineSource *new_source) {
+  ConnectionTransaction transaction;
+  for (int in_port = 0; in_port < dest->getNumberOfInputPorts(); ++in_port) {
+    QString input_name = dest->getInputPortName(in_port);
+    vtkSMInputProperty *ip = vtkSMInputProperty::SafeDownCast(
+        dest->getProxy()->GetProperty(input_name.toLocal8Bit().data()));
+    if (!ip)
+      continue;
+    bool replaced = false;
+    std::vector<vtkSMProxy *> inputPtrs;
+    std::vector<unsigned int> inputPorts;
+    vtkSMPropertyHelper helper(ip);
+    unsigned int numProxies = helper.GetNumberOfElements();
+    for (unsigned int cc = 0; cc < numProxies; cc++) {
+      vtkSMProxy *proxy = helper.GetAsProxy(cc);
+      if (proxy == old_source->getProxy()) {
+        proxy = new_source->getProxy();
+        replaced = true;
+      }
+      inputPtrs.push_back(proxy);
+      inputPorts.push_back(helper.GetOutputPort(cc));
+    }
+    if (!replaced)
+      continue;
+    ip->SetProxies(static_cast<unsigned int>(inputPtrs.size()), &inputPtrs[0], &inputPorts[0]);
+    transaction_modified(dest);
+  }
+}
+
+// Sources and views of the server manager model, sorted by global id. Filled once and then kept up to date
+// from the model's add/remove signals.
+static std::vector<pqPipelineSource *> source_registry;
+static std::vector<pqView *> view_registry;
+
+template <typename T>
+static bool global_id_less(T *a, T *b) {
+  return a->getProxy()->GetGlobalID() < b->getProxy()->GetGlobalID();
 }
 
-std::vector<pqPipelineSource *> get_sources() {
-  auto session = vtkSMProxyManager::GetProxyManager()->GetActiveSession();
-  if (!session)
-    return {};
-  auto iter = vtkSmartPointer<vtkSMProxyIterator>::New();
-  iter->SetSession(session);
-  iter->SetModeToOneGroup();
-  std::vector<pqPipelineSource *> result;
+template <typename T>
+static void registry_insert(std::vector<T *> &registry, T *item) {
+  auto it = std::lower_bound(registry.begin(), registry.end(), item, global_id_less<T>);
+  if (it == registry.end() || *it != item)
+    registry.insert(it, item);
+}
+
+template <typename T>
+static void registry_remove(std::vector<T *> &registry, T *item) {
+  auto it = std::find(registry.begin(), registry.end(), item);
+  if (it != registry.end())
+    registry.erase(it);
+}
+
+static void track_registries() {
+  static bool tracked = false;
+  if (tracked)
+    return;
+  tracked = true;
   auto smModel = pqApplicationCore::instance()->getServerManagerModel();
-  for (iter->Begin("sources"); !iter->IsAtEnd(); iter->Next()) {
-    auto proxy = iter->GetProxy();
-    auto source_proxy = vtkSMSourceProxy::SafeDownCast(proxy);
-    if (!source_proxy)
-      continue;
-    auto pipeline_source = smModel->findItem<pqPipelineSource *>(source_proxy);
-    if (pipeline_source)
-      result.emplace_back(pipeline_source);
+  for (pqPipelineSource *source : smModel->findItems<pqPipelineSource *>()) {
+    source_registry.push_back(source);
   }
-  std::sort(result.begin(), result.end(), [](pqPipelineSource *a, pqPipelineSource *b) -> bool {
-    return a->getProxy()->GetGlobalID() < b->getProxy()->GetGlobalID();
+  std::sort(source_registry.begin(), source_registry.end(), global_id_less<pqPipelineSource>);
+  for (pqView *view : smModel->findItems<pqView *>()) {
+    view_registry.push_back(view);
+  }
+  std::sort(view_registry.begin(), view_registry.end(), global_id_less<pqView>);
+
+  QObject::connect(smModel, &pqServerManagerModel::sourceAdded, smModel, [](pqPipelineSource *source) {
+    registry_insert(source_registry, source);
+  });
+  QObject::connect(smModel, &pqServerManagerModel::sourceRemoved, smModel, [](pqPipelineSource *source) {
+    registry_remove(source_registry, source);
+  });
+  QObject::connect(smModel, &pqServerManagerModel::viewAdded, smModel, [](pqView *view) {
+    registry_insert(view_registry, view);
+  });
+  QObject::connect(smModel, &pqServerManagerModel::viewRemoved, smModel, [](pqView *view) {
+    registry_remove(view_registry, view);
   });
-  return result;
 }
 
-std::vector<pqView*> get_views() {
-  auto session = vtkSMProxyManager::GetProxyManager()->GetActiveSession();
-  if (!session)
-    return {};
-  auto iter = vtkSmartPointer<vtkSMProxyIterator>::New();
-  iter->SetSession(session);
-  iter->SetModeToOneGroup();
-  std::vector<pqView *> result;
-  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
-  for (iter->Begin("views"); !iter->IsAtEnd(); iter->Next()) {
-    auto proxy = vtkSMViewProxy::SafeDownCast(iter->GetProxy());
-    if (!proxy)
-      continue;
+const std::vector<pqPipelineSource *> &get_sources() {
+  track_registries();
+  return source_registry;
+}
 
-    auto view = smModel->findItem<pqView *>(proxy);
-    if (view)
-      result.emplace_back(view);
-  }
-  return result;
+const std::vector<pqView*> &get_views() {
+  track_registries();
+  return view_registry;
 }
 
 std::pair<bool, bool> output_visibiility(pqPipelineSource *source, int out_port) {
@@ -219,6 +310,7 @@ std::pair<bool, bool> output_visibiility(pqPipelineSource *source, int out_port)
   pqView *activeView = pqActiveObjects::instance().activeView();
   vtkSMViewProxy *viewProxy = activeView ? activeView->getViewProxy() : nullptr;
   if (viewProxy) {
+    perf_counters::increment(perf_counters::VISIBILITY_QUERIES);
     visible = controller->GetVisibility(output->getSourceProxy(), out_port, viewProxy);
     pqDataRepresentation *representation = output->getRepresentation(activeView);
     if (representation) {
@@ -229,6 +321,21 @@ std::pair<bool, bool> output_visibiility(pqPipelineSource *source, int out_port)
   return {visible, scalar_bar};
 }
 
+std::unordered_set<pqOutputPort *> visible_output_ports() {
+  perf_counters::increment(perf_counters::VISIBILITY_QUERIES);
+  std::unordered_set<pqOutputPort *> ports;
+  for (pqView *view : get_views()) {
+    for (pqRepresentation *representation : view->getRepresentations()) {
+      auto data_representation = qobject_cast<pqDataRepresentation *>(representation);
+      if (!data_representation || !data_representation->isVisible())
+        continue;
+      if (pqOutputPort *port = data_representation->getOutputPortFromInput())
+        ports.insert(port);
+    }
+  }
+  return ports;
+}
+
 void toggle_output_visibility(pqPipelineSource *source, int out_port) {
   pqView *activeView = pqActiveObjects::instance().activeView();
   vtkSMViewProxy *viewProxy = activeView ? activeView->getViewProxy() : nullptr;
@@ -277,6 +384,63 @@ void set_source_scalar_bar_visiblity(pqPipelineSource *source, bool visible) {
   }
 }
 
+namespace {
+
+void accept_unchecked_values(vtkSMProxy *proxy, std::set<vtkSMProxy *> &accepted) {
+  if (!proxy || !accepted.insert(proxy).second)
+    return;
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  auto iter = vtkSmartPointer<vtkSMPropertyIterator>::Take(proxy->NewPropertyIterator());
+  for (iter->Begin(); !iter->IsAtEnd(); iter->Next()) {
+    vtkSMProperty *prop = iter->GetProperty();
+    // connections are made directly, never through unchecked values
+    if (!prop || prop->GetInformationOnly() || vtkSMInputProperty::SafeDownCast(prop))
+      continue;
+    if (auto dvp = vtkSMDoubleVectorProperty::SafeDownCast(prop)) {
+      std::vector<double> values(dvp->GetNumberOfUncheckedElements());
+      for (unsigned int i = 0; i < values.size(); ++i)
+        values[i] = dvp->GetUncheckedElement(i);
+      dvp->SetElements(values.data(), static_cast<unsigned int>(values.size()));
+    } else if (auto ivp = vtkSMIntVectorProperty::SafeDownCast(prop)) {
+      std::vector<int> values(ivp->GetNumberOfUncheckedElements());
+      for (unsigned int i = 0; i < values.size(); ++i)
+        values[i] = ivp->GetUncheckedElement(i);
+      ivp->SetElements(values.data(), static_cast<unsigned int>(values.size()));
+    } else if (auto idvp = vtkSMIdTypeVectorProperty::SafeDownCast(prop)) {
+      std::vector<vtkIdType> values(idvp->GetNumberOfUncheckedElements());
+      for (unsigned int i = 0; i < values.size(); ++i)
+        values[i] = idvp->GetUncheckedElement(i);
+      idvp->SetElements(values.data(), static_cast<unsigned int>(values.size()));
+    } else if (auto svp = vtkSMStringVectorProperty::SafeDownCast(prop)) {
+      std::vector<std::string> values(svp->GetNumberOfUncheckedElements());
+      for (unsigned int i = 0; i < values.size(); ++i) {
+        const char *value = svp->GetUncheckedElement(i);
+        values[i] = value ? value : "";
+      }
+      svp->SetElements(values);
+    } else if (auto pp = vtkSMProxyProperty::SafeDownCast(prop)) {
+      std::vector<vtkSMProxy *> proxies(pp->GetNumberOfUncheckedProxies());
+      for (unsigned int i = 0; i < proxies.size(); ++i)
+        proxies[i] = pp->GetUncheckedProxy(i);
+      pp->SetProxies(static_cast<unsigned int>(proxies.size()), proxies.data());
+      // proxies edited through the property, e.g. the plane of Slice or Clip, keep their own unchecked values,
+      // which Apply commits through the sub-widget of the property. Other pipeline sources are left alone.
+      for (vtkSMProxy *value : proxies) {
+        if (!smModel->findItem<pqPipelineSource *>(value))
+          accept_unchecked_values(value, accepted);
+      }
+    }
+  }
+  proxy->UpdateVTKObjects();
+}
+
+}
+
+void accept_unchecked_values(pqPipelineSource *source) {
+  std::set<vtkSMProxy *> accepted;
+  accept_unchecked_values(source->getProxy(), accepted);
+}
+
 std::vector<std::string> input_datatypes(pqPipelineFilter *filter, int in_port) {
   QString input_name = filter->getInputPortName(in_port);
   vtkSMInputProperty *ip = vtkSMInputProperty::SafeDownCast(
@@ -306,7 +470,7 @@ QColor output_dataset_color(pqPipelineSource *filter, int port_index) {
   auto port = filter->getOutputPort(port_index);
   if (!port)
     return default_color;
-  auto info = port->getDataInformation();
+  auto info = DataInformationCache::instance()->get(port);
   if (!info)
     return default_color;
 
@@ -331,33 +495,42 @@ QColor output_dataset_color(pqPipelineSource *filter, int port_index) {
   return default_color;
 }
 
-pqPipelineSource* get_dummy_source() {
-  vtkSMProxyManager* proxyManager = vtkSMProxyManager::GetProxyManager();
-  if (!proxyManager)
-    return nullptr;
-  vtkSMSessionProxyManager *sessionProxyManager = proxyManager->GetActiveSessionProxyManager();
-  if (!sessionProxyManager)
-    return nullptr;
-  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+// Handle to the dummy source. The pqPipelineSource is deleted when the proxy is unregistered or the session
+// goes away, which resets the handle. Dummy sources registered by others (e.g. loading a state) are picked up
+// from the sourceAdded signal, so the proxy manager is only scanned once.
+static QPointer<pqPipelineSource> dummy_source;
+static bool dummy_source_tracked = false;
 
-  pqPipelineSource* dummy = nullptr;
+static bool is_dummy_source(pqPipelineSource *source) {
+  return std::string(source->getProxy()->GetXMLName()) == "NetworkEditorDummySource";
+}
 
-  // find NetworkEditorDummySource
-  vtkNew<vtkCollection> coll;
-  sessionProxyManager->GetProxies("sources", "NetworkEditorDummySource", coll);
-  coll->InitTraversal();
-  vtkObject* obj = coll->GetNextItemAsObject();
-  while (obj != nullptr) {
-    vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(obj);
-    if (proxy) {
-      auto pipeline_source = smModel->findItem<pqPipelineSource *>(proxy);
-      if (pipeline_source && (pipeline_source->getSMName() == "NetworkEditorDummySource")) {
-        dummy = pipeline_source;
+static pqPipelineSource *find_dummy_source() {
+  auto smModel = pqApplicationCore::instance()->getServerManagerModel();
+  if (!dummy_source_tracked) {
+    dummy_source_tracked = true;
+    for (pqPipelineSource *source : smModel->findItems<pqPipelineSource *>()) {
+      if (is_dummy_source(source) && source->getSMName() == "NetworkEditorDummySource") {
+        dummy_source = source;
         break;
       }
     }
-    obj = coll->GetNextItemAsObject();
+    QObject::connect(smModel, &pqServerManagerModel::sourceAdded, smModel, [](pqPipelineSource *source) {
+      if (!dummy_source && is_dummy_source(source)) {
+        dummy_source = source;
+      }
+    });
   }
+  if (!dummy_source || dummy_source->getServer() != pqActiveObjects::instance().activeServer())
+    return nullptr;
+  // the source is registered before it is renamed
+  if (dummy_source->getSMName() != "NetworkEditorDummySource")
+    return nullptr;
+  return dummy_source;
+}
+
+pqPipelineSource* get_dummy_source() {
+  pqPipelineSource* dummy = find_dummy_source();
 
   // not found, create new one
   if (!dummy) {
@@ -365,6 +538,7 @@ pqPipelineSource* get_dummy_source() {
     dummy = builder->createSource("sources", "NetworkEditorDummySource", pqActiveObjects::instance().activeServer());
     if (dummy) {
       dummy->rename("NetworkEditorDummySource");
+      dummy_source = dummy;
     }
   }
 
@@ -372,30 +546,14 @@ pqPipelineSource* get_dummy_source() {
 }
 
 void collect_dummy_source() {
-  vtkSMProxyManager* proxyManager = vtkSMProxyManager::GetProxyManager();
-  if (!proxyManager)
-    return;
-  vtkSMSessionProxyManager *sessionProxyManager = proxyManager->GetActiveSessionProxyManager();
-  if (!sessionProxyManager)
-    return;
   auto smModel = pqApplicationCore::instance()->getServerManagerModel();
 
   // find NetworkEditorDummySource
   std::set<pqPipelineSource*> dummies;
-  vtkNew<vtkCollection> coll;
-  sessionProxyManager->GetProxies("sources", "NetworkEditorDummySource", coll);
-  coll->InitTraversal();
-  vtkObject* obj = coll->GetNextItemAsObject();
-  while (obj != nullptr) {
-    vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(obj);
-    if (proxy) {
-      auto pipeline_source = smModel->findItem<pqPipelineSource *>(proxy);
-      if (pipeline_source && (pipeline_source->getSMName() == "NetworkEditorDummySource")) {
-        dummies.insert(pipeline_source);
-        break;
-      }
-    }
-    obj = coll->GetNextItemAsObject();
+  if (pqPipelineSource *dummy = find_dummy_source()) {
+    dummies.insert(dummy);
+  } else {
+    return;
   }
 
   std::set<pqPipelineFilter*> consumers;
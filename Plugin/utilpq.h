@@ -3,9 +3,11 @@
 
 #include <QColor>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 class pqPipelineSource;
+class pqOutputPort;
 class pqPipelineFilter;
 class vtkSMParaViewPipelineControllerWithRendering;
 class pqView;
@@ -21,16 +23,34 @@ bool can_connect(pqPipelineSource *source, int out_port, pqPipelineFilter *dest,
 
 bool can_connect(pqPipelineSource *source, int out_port, const char* groupname, const char* name);
 
+// Batches connection edits. While a transaction is open, add_connection and remove_connection only change the
+// input properties. When the outermost transaction ends, each modified filter is updated once, the dummy source
+// is collected and views are rendered once.
+class ConnectionTransaction {
+ public:
+  ConnectionTransaction();
+  ~ConnectionTransaction();
+  ConnectionTransaction(const ConnectionTransaction &) = delete;
+  ConnectionTransaction &operator=(const ConnectionTransaction &) = delete;
+};
+
 void add_connection(pqPipelineSource *source, int out_port, pqPipelineFilter *dest, int in_port);
 
 void remove_connection(pqPipelineSource *source, int out_port, pqPipelineFilter *dest, int in_port);
 
-std::vector<pqPipelineSource *> get_sources();
+// Makes dest read from new_source wherever it reads from old_source, keeping output ports and the order of inputs.
+void replace_input(pqPipelineFilter *dest, pqPipelineSource *old_source, pqPipelineSource *new_source);
+
+// Sources and views sorted by global id. The returned lists change when sources or views are added or removed.
+const std::vector<pqPipelineSource *> &get_sources();
 
-std::vector<pqView*> get_views();
+const std::vector<pqView*> &get_views();
 
 std::pair<bool, bool> output_visibiility(pqPipelineSource *source, int out_port);
 
+// Output ports that are shown in at least one view, found in a single pass over the representations.
+std::unordered_set<pqOutputPort *> visible_output_ports();
+
 void toggle_output_visibility(pqPipelineSource *source, int out_port);
 
 void toggle_source_visibility(pqPipelineSource *source);
@@ -39,6 +59,11 @@ void set_source_visiblity(pqPipelineSource *source, bool visible);
 
 void set_source_scalar_bar_visiblity(pqPipelineSource *source, bool visible);
 
+// The properties panel keeps edits in the unchecked values of the properties until Apply. Copies them to the
+// checked values and pushes them to the server, like Apply does for all sources. Proxies that the properties point
+// to, such as the plane of Slice or Clip, are accepted recursively before the source itself is updated.
+void accept_unchecked_values(pqPipelineSource *source);
+
 std::vector<std::string> input_datatypes(pqPipelineFilter *filter, int in_port);
 
 const QColor default_color(188, 188, 188);
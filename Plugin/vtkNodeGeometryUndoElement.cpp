@@ -0,0 +1,58 @@
+#include "vtkNodeGeometryUndoElement.h"
+#include "NetworkEditor.h"
+#include "node_layout.h"
+
+#include <vtkObjectFactory.h>
+#include <vtkSMProxy.h>
+#include <vtkSMSession.h>
+
+namespace ParaViewNetworkEditor {
+
+vtkStandardNewMacro(vtkNodeGeometryUndoElement);
+
+vtkNodeGeometryUndoElement::vtkNodeGeometryUndoElement() = default;
+
+vtkNodeGeometryUndoElement::~vtkNodeGeometryUndoElement() = default;
+
+void vtkNodeGeometryUndoElement::PrintSelf(ostream &os, vtkIndent indent) {
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number of nodes: " << this->deltas.size() << endl;
+}
+
+void vtkNodeGeometryUndoElement::AddNode(vtkTypeUInt32 id, double dx, double dy, double dw, double dh) {
+  this->deltas.push_back({id, (float) dx, (float) dy, (float) dw, (float) dh});
+}
+
+bool vtkNodeGeometryUndoElement::IsEmpty() const {
+  return this->deltas.empty();
+}
+
+void vtkNodeGeometryUndoElement::SetNetworkEditor(NetworkEditor *network_editor) {
+  this->editor = network_editor;
+}
+
+int vtkNodeGeometryUndoElement::Undo() {
+  return this->Apply(-1.);
+}
+
+int vtkNodeGeometryUndoElement::Redo() {
+  return this->Apply(1.);
+}
+
+int vtkNodeGeometryUndoElement::Apply(double sign) {
+  vtkSMSession *session = this->GetSession();
+  if (!session)
+    return 0;
+
+  for (const Delta &delta : this->deltas) {
+    if (!node_layout::move(delta.id, QPointF(sign * delta.dx, sign * delta.dy), QSizeF(sign * delta.dw, sign * delta.dh)))
+      continue;
+    auto proxy = vtkSMProxy::SafeDownCast(session->GetRemoteObject(delta.id));
+    if (proxy && this->editor) {
+      this->editor->updateSourcePosition(proxy);
+    }
+  }
+  return 1;
+}
+
+}
@@ -0,0 +1,51 @@
+#ifndef PARAVIEWNETWORKEDITOR_PLUGIN_VTKNODEGEOMETRYUNDOELEMENT_H_
+#define PARAVIEWNETWORKEDITOR_PLUGIN_VTKNODEGEOMETRYUNDOELEMENT_H_
+
+#include <vtkSMUndoElement.h>
+#include <vtkType.h>
+#include <QPointer>
+#include <vector>
+
+namespace ParaViewNetworkEditor {
+
+class NetworkEditor;
+
+// Single undo element for moving (or resizing) any number of nodes at once.
+// Stores one (proxy id, dx, dy, dw, dh) record per node and applies it to the
+// node layout table.
+class vtkNodeGeometryUndoElement : public vtkSMUndoElement {
+ public:
+  static vtkNodeGeometryUndoElement *New();
+  vtkTypeMacro(vtkNodeGeometryUndoElement, vtkSMUndoElement);
+  void PrintSelf(ostream &os, vtkIndent indent) override;
+
+  int Undo() override;
+  int Redo() override;
+
+  void AddNode(vtkTypeUInt32 id, double dx, double dy, double dw = 0., double dh = 0.);
+  bool IsEmpty() const;
+
+  void SetNetworkEditor(NetworkEditor *);
+
+ protected:
+  vtkNodeGeometryUndoElement();
+  ~vtkNodeGeometryUndoElement() override;
+
+  int Apply(double sign);
+
+  struct Delta {
+    vtkTypeUInt32 id;
+    float dx, dy, dw, dh;
+  };
+  std::vector<Delta> deltas;
+
+  QPointer<NetworkEditor> editor;
+
+ private:
+  vtkNodeGeometryUndoElement(const vtkNodeGeometryUndoElement &) = delete;
+  void operator=(const vtkNodeGeometryUndoElement &) = delete;
+};
+
+}
+
+#endif //PARAVIEWNETWORKEDITOR_PLUGIN_VTKNODEGEOMETRYUNDOELEMENT_H_
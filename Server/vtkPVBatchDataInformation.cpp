@@ -0,0 +1,163 @@
+#include "vtkPVBatchDataInformation.h"
+
+#include <vtkAlgorithm.h>
+#include <vtkClientServerStream.h>
+#include <vtkMultiProcessStream.h>
+#include <vtkObjectFactory.h>
+#include <vtkPVSessionBase.h>
+#include <vtkProcessModule.h>
+#include <vtkSISourceProxy.h>
+#include <vtkSessionIterator.h>
+
+namespace {
+
+const int magic_number = 828792;
+
+// The session that runs the request, its SI objects hold the pipeline of this process.
+vtkPVSessionBase *local_session() {
+  vtkProcessModule *pm = vtkProcessModule::GetProcessModule();
+  if (!pm)
+    return nullptr;
+  if (auto session = vtkPVSessionBase::SafeDownCast(pm->GetActiveSession()))
+    return session;
+  vtkSessionIterator *iter = pm->NewSessionIterator();
+  vtkPVSessionBase *session = nullptr;
+  for (iter->InitTraversal(); !session && !iter->IsDoneWithTraversal(); iter->GoToNextItem()) {
+    session = vtkPVSessionBase::SafeDownCast(iter->GetCurrentSession());
+  }
+  iter->Delete();
+  return session;
+}
+
+}
+
+vtkStandardNewMacro(vtkPVBatchDataInformation);
+
+vtkPVBatchDataInformation::vtkPVBatchDataInformation() = default;
+
+vtkPVBatchDataInformation::~vtkPVBatchDataInformation() = default;
+
+void vtkPVBatchDataInformation::PrintSelf(ostream &os, vtkIndent indent) {
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Number of ports: " << this->Ports.size() << endl;
+}
+
+void vtkPVBatchDataInformation::AddPort(vtkTypeUInt32 sourceId, int port) {
+  Port entry;
+  entry.SourceId = sourceId;
+  entry.Index = port;
+  this->Ports.push_back(entry);
+}
+
+int vtkPVBatchDataInformation::GetNumberOfPorts() const {
+  return static_cast<int>(this->Ports.size());
+}
+
+vtkPVDataInformation *vtkPVBatchDataInformation::GetDataInformation(int index) const {
+  if (index < 0 || index >= this->GetNumberOfPorts())
+    return nullptr;
+  return this->Ports[index].Information;
+}
+
+void vtkPVBatchDataInformation::CopyFromObject(vtkObject *) {
+  // the object of the request is the algorithm of the first port, the others are looked up by id
+  vtkPVSessionBase *session = local_session();
+  for (Port &port : this->Ports) {
+    port.Information = nullptr;
+    auto source = session ? vtkSISourceProxy::SafeDownCast(session->GetSIObject(port.SourceId)) : nullptr;
+    auto algorithm = source ? vtkAlgorithm::SafeDownCast(source->GetVTKObject()) : nullptr;
+    if (!algorithm || port.Index < 0 || port.Index >= algorithm->GetNumberOfOutputPorts())
+      continue;
+    port.Information = vtkSmartPointer<vtkPVDataInformation>::New();
+    port.Information->SetPortNumber(port.Index);
+    port.Information->CopyFromObject(algorithm);
+  }
+}
+
+void vtkPVBatchDataInformation::AddInformation(vtkPVInformation *information) {
+  auto other = vtkPVBatchDataInformation::SafeDownCast(information);
+  if (!other || other->Ports.size() != this->Ports.size())
+    return;
+  for (size_t i = 0; i < this->Ports.size(); ++i) {
+    vtkPVDataInformation *info = other->Ports[i].Information;
+    if (!info)
+      continue;
+    if (!this->Ports[i].Information) {
+      this->Ports[i].Information = vtkSmartPointer<vtkPVDataInformation>::New();
+      this->Ports[i].Information->SetPortNumber(this->Ports[i].Index);
+    }
+    this->Ports[i].Information->AddInformation(info);
+  }
+}
+
+void vtkPVBatchDataInformation::CopyToStream(vtkClientServerStream *css) {
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<int>(this->Ports.size());
+  for (const Port &port : this->Ports) {
+    *css << (port.Information != nullptr);
+    if (!port.Information)
+      continue;
+    // each port is nested as the stream of its own data information
+    vtkClientServerStream portStream;
+    port.Information->CopyToStream(&portStream);
+    const unsigned char *data = nullptr;
+    size_t length = 0;
+    portStream.GetData(&data, &length);
+    *css << vtkClientServerStream::InsertArray(data, static_cast<int>(length));
+  }
+  *css << vtkClientServerStream::End;
+}
+
+void vtkPVBatchDataInformation::CopyFromStream(const vtkClientServerStream *css) {
+  int count = 0;
+  if (!css->GetArgument(0, 0, &count) || count < 0) {
+    vtkErrorMacro("Error parsing the number of ports from message.");
+    return;
+  }
+  this->Ports.resize(count);
+  int argument = 1;
+  for (Port &port : this->Ports) {
+    port.Information = nullptr;
+    bool present = false;
+    if (!css->GetArgument(0, argument++, &present)) {
+      vtkErrorMacro("Error parsing the data information of a port from message.");
+      return;
+    }
+    if (!present)
+      continue;
+    vtkTypeUInt32 length = 0;
+    css->GetArgumentLength(0, argument, &length);
+    std::vector<unsigned char> data(length);
+    if (!css->GetArgument(0, argument++, data.data(), length)) {
+      vtkErrorMacro("Error parsing the data information of a port from message.");
+      return;
+    }
+    vtkClientServerStream portStream;
+    portStream.SetData(data.data(), length);
+    port.Information = vtkSmartPointer<vtkPVDataInformation>::New();
+    port.Information->SetPortNumber(port.Index);
+    port.Information->CopyFromStream(&portStream);
+  }
+}
+
+void vtkPVBatchDataInformation::CopyParametersToStream(vtkMultiProcessStream &str) {
+  str << magic_number << static_cast<int>(this->Ports.size());
+  for (const Port &port : this->Ports) {
+    str << port.SourceId << port.Index;
+  }
+}
+
+void vtkPVBatchDataInformation::CopyParametersFromStream(vtkMultiProcessStream &str) {
+  int magic = 0, count = 0;
+  str >> magic >> count;
+  if (magic != magic_number || count < 0) {
+    vtkErrorMacro("Magic number mismatch.");
+    return;
+  }
+  this->Ports.clear();
+  for (int i = 0; i < count; ++i) {
+    Port port;
+    str >> port.SourceId >> port.Index;
+    this->Ports.push_back(port);
+  }
+}
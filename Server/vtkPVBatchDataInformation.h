@@ -0,0 +1,47 @@
+#ifndef PARAVIEWNETWORKEDITOR_SERVER_VTKPVBATCHDATAINFORMATION_H_
+#define PARAVIEWNETWORKEDITOR_SERVER_VTKPVBATCHDATAINFORMATION_H_
+
+#include "NetworkEditorServerModule.h"
+#include <vtkPVDataInformation.h>
+#include <vtkPVInformation.h>
+#include <vtkSmartPointer.h>
+#include <vector>
+
+// Data information of any number of output ports, gathered in a single request. Ports are given by the global id
+// of their source proxy and the port index. On the server, each port is gathered like vtkSMOutputPort does, and
+// the information of the ports is reduced over the ranks port by port.
+class NETWORKEDITORSERVER_EXPORT vtkPVBatchDataInformation : public vtkPVInformation {
+ public:
+  static vtkPVBatchDataInformation *New();
+  vtkTypeMacro(vtkPVBatchDataInformation, vtkPVInformation);
+  void PrintSelf(ostream &os, vtkIndent indent) override;
+
+  void AddPort(vtkTypeUInt32 sourceId, int port);
+  int GetNumberOfPorts() const;
+  // Information of the index-th added port, nullptr if its source was not found on the server.
+  vtkPVDataInformation *GetDataInformation(int index) const;
+
+  void CopyFromObject(vtkObject *) override;
+  void AddInformation(vtkPVInformation *) override;
+  void CopyToStream(vtkClientServerStream *) override;
+  void CopyFromStream(const vtkClientServerStream *) override;
+  void CopyParametersToStream(vtkMultiProcessStream &) override;
+  void CopyParametersFromStream(vtkMultiProcessStream &) override;
+
+ protected:
+  vtkPVBatchDataInformation();
+  ~vtkPVBatchDataInformation() override;
+
+  struct Port {
+    vtkTypeUInt32 SourceId {0};
+    int Index {0};
+    vtkSmartPointer<vtkPVDataInformation> Information;
+  };
+  std::vector<Port> Ports;
+
+ private:
+  vtkPVBatchDataInformation(const vtkPVBatchDataInformation&) = delete;
+  void operator=(const vtkPVBatchDataInformation&) = delete;
+};
+
+#endif //PARAVIEWNETWORKEDITOR_SERVER_VTKPVBATCHDATAINFORMATION_H_
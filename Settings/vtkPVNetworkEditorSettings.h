@@ -31,12 +31,16 @@ class NETWORKEDITORSETTINGS_EXPORT vtkPVNetworkEditorSettings : public vtkObject
   vtkSetMacro(PipelineScreenshotTransparency, bool);
   vtkGetMacro(PipelineScreenshotTransparency, bool);
 
+  vtkSetMacro(PipelineScreenshotScale, double);
+  vtkGetMacro(PipelineScreenshotScale, double);
+
  protected:
   bool SwapOnStartup {false};
   bool UpdateActiveObject {true};
   int TooltipWakeupDelay {700};
   bool AutoSavePipelineScreenshot {true};
   bool PipelineScreenshotTransparency {true};
+  double PipelineScreenshotScale {2.0};
   std::string AutoSavePipelineSuffix {".pipeline.png"};
 
   vtkPVNetworkEditorSettings();